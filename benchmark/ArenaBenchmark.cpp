@@ -0,0 +1,87 @@
+/*
+ * @author: Pei Mu
+ * @description: Request cycle of the monotonic arena vs. the memory pool
+ * @data: 17th Oct 2026
+ * */
+
+#include "MemoryPool.hpp"
+#include "MonotonicArena.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+const std::size_t g_RequestNum = 2000;
+const std::size_t g_ObjectNum = 1000;
+
+struct Point {
+  explicit Point(const int &x_val) : x(x_val), y(0), z(0) {}
+
+  int x, y, z;
+};
+
+/*
+ * A type with a destructor to call.
+ * */
+struct Message {
+  explicit Message(const int &id_val) : id(id_val) {}
+  ~Message() { sink += id; }
+
+  int id;
+  int payload[5] = {};
+  static volatile int sink;
+};
+
+volatile int Message::sink = 0;
+
+double elapsed_ns(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         static_cast<double>(g_RequestNum * g_ObjectNum);
+}
+
+/*
+ * Every request constructs g_ObjectNum objects and drops them all at the end.
+ * Print the nanoseconds per object.
+ * */
+template <typename element_type> void run(const char *name) {
+  std::vector<element_type *> chunks(g_ObjectNum);
+
+  memory_pool::MemoryPool<element_type> pool(g_ObjectNum);
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t request = 0; request < g_RequestNum; request++) {
+    for (std::size_t i = 0; i < g_ObjectNum; i++)
+      chunks[i] = pool.construct(static_cast<int>(i));
+    for (std::size_t i = 0; i < g_ObjectNum; i++)
+      pool.destroy(chunks[i]);
+  }
+  double destroy_time = elapsed_ns(start);
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t request = 0; request < g_RequestNum; request++) {
+    for (std::size_t i = 0; i < g_ObjectNum; i++)
+      chunks[i] = pool.construct(static_cast<int>(i));
+    pool.destroy_n(chunks.data(), g_ObjectNum);
+  }
+  double destroy_n_time = elapsed_ns(start);
+
+  memory_pool::MonotonicArena<element_type> arena(g_ObjectNum);
+  start = std::chrono::steady_clock::now();
+  for (std::size_t request = 0; request < g_RequestNum; request++) {
+    for (std::size_t i = 0; i < g_ObjectNum; i++)
+      chunks[i] = arena.construct(static_cast<int>(i));
+    arena.reset();
+  }
+  double reset_time = elapsed_ns(start);
+
+  printf("%8s %18.2f %18.2f %18.2f\n", name, destroy_time, destroy_n_time,
+         reset_time);
+}
+
+int main() {
+  printf("%8s %18s %18s %18s\n", "type", "destroy(ns/obj)", "destroy_n(ns/obj)",
+         "reset(ns/obj)");
+  run<Point>("Point");
+  run<Message>("Message");
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * @author: Pei Mu
+ * @description: Contention benchmark of the thread-safe memory pools
+ * @data: 16th Oct 2026
+ * */
+
+#include "ConcurrentMemoryPool.hpp"
+#include "LockFreeMemoryPool.hpp"
+#include "MemoryPool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const std::size_t g_RoundNum = 2000;
+const std::size_t g_BatchNum = 64;
+
+struct Payload {
+  std::size_t data[4];
+};
+
+/*
+ * The baseline: one MemoryPool shared by all threads behind a mutex.
+ * */
+class MutexMemoryPool {
+public:
+  Payload *construct() {
+    std::lock_guard<std::mutex> guard(lock);
+    return pool.construct();
+  }
+
+  void destroy(Payload *const chunk) {
+    std::lock_guard<std::mutex> guard(lock);
+    pool.destroy(chunk);
+  }
+
+private:
+  std::mutex lock;
+  memory_pool::MemoryPool<Payload> pool;
+};
+
+/*
+ * Every thread constructs a batch of objects, touches them and destroys them
+ * again, so all threads hammer the shared free list at the same time.
+ * Return the nanoseconds per construct/destroy pair.
+ * */
+template <typename pool_type>
+double run(pool_type &pool, const std::size_t &thread_num) {
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t t = 0; t < thread_num; t++) {
+    threads.emplace_back([&pool]() {
+      Payload *chunks[g_BatchNum];
+      for (std::size_t round = 0; round < g_RoundNum; round++) {
+        for (std::size_t i = 0; i < g_BatchNum; i++) {
+          chunks[i] = pool.construct();
+          chunks[i]->data[0] = i;
+        }
+        for (std::size_t i = 0; i < g_BatchNum; i++)
+          pool.destroy(chunks[i]);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(g_RoundNum * g_BatchNum);
+}
+
+int main(int argc, char **argv) {
+  std::size_t max_threads = std::thread::hardware_concurrency();
+  if (argc > 1)
+    max_threads = std::strtoul(argv[1], nullptr, 10);
+  if (max_threads == 0)
+    max_threads = 1;
+
+  printf("%8s %16s %16s %16s\n", "threads", "mutex(ns/op)", "lock-free(ns/op)",
+         "magazine(ns/op)");
+  for (std::size_t thread_num = 1; thread_num <= max_threads;
+       thread_num <<= 1) {
+    MutexMemoryPool mutex_pool;
+    memory_pool::LockFreeMemoryPool<Payload> lock_free_pool;
+    memory_pool::ConcurrentMemoryPool<Payload> concurrent_pool;
+    double mutex_time = run(mutex_pool, thread_num);
+    double lock_free_time = run(lock_free_pool, thread_num);
+    double concurrent_time = run(concurrent_pool, thread_num);
+    printf("%8zu %16.2f %16.2f %16.2f\n", thread_num, mutex_time,
+           lock_free_time, concurrent_time);
+  }
+  return 0;
+}
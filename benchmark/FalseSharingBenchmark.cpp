@@ -0,0 +1,75 @@
+/*
+ * @author: Pei Mu
+ * @description: False sharing benchmark of the aligned memory pool
+ * @data: 17th Oct 2026
+ * */
+
+#include "MemoryPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+const std::size_t g_IncrementNum = 10000000;
+const std::size_t g_CacheLine = 64;
+
+struct Counter {
+  std::atomic<std::size_t> value{0};
+};
+
+typedef memory_pool::MemoryPool<Counter> PackedPool;
+typedef memory_pool::MemoryPool<Counter, memory_pool::MallocBlockProvider,
+                                memory_pool::NoStats,
+                                memory_pool::GeometricGrowth<>, g_CacheLine>
+    PaddedPool;
+
+/*
+ * Every thread increments its own counter, the counters are constructed one
+ * after another from the same pool. Packed, several counters share a cache
+ * line, which bounces between the cores at every increment.
+ * Return the nanoseconds per increment.
+ * */
+template <typename pool_type> double run(const std::size_t &thread_num) {
+  pool_type pool;
+  std::vector<Counter *> counters;
+  for (std::size_t t = 0; t < thread_num; t++)
+    counters.emplace_back(pool.construct());
+
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t t = 0; t < thread_num; t++) {
+    threads.emplace_back([counter = counters[t]]() {
+      for (std::size_t i = 0; i < g_IncrementNum; i++)
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  for (auto counter : counters)
+    pool.destroy(counter);
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(g_IncrementNum);
+}
+
+int main(int argc, char **argv) {
+  std::size_t max_threads = std::thread::hardware_concurrency();
+  if (argc > 1)
+    max_threads = std::strtoul(argv[1], nullptr, 10);
+  if (max_threads == 0)
+    max_threads = 1;
+
+  printf("%8s %16s %16s %10s\n", "threads", "packed(ns/op)", "padded(ns/op)",
+         "slowdown");
+  for (std::size_t thread_num = 1; thread_num <= max_threads;
+       thread_num <<= 1) {
+    double packed_time = run<PackedPool>(thread_num);
+    double padded_time = run<PaddedPool>(thread_num);
+    printf("%8zu %16.2f %16.2f %10.2f\n", thread_num, packed_time,
+           padded_time, packed_time / padded_time);
+  }
+  return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * @author: Pei Mu
+ * @description: std::pmr::map insert and erase, default vs. pool resource
+ * @data: 16th Oct 2026
+ * */
+
+#include "PoolMemoryResource.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+const std::size_t g_RoundNum = 20;
+const std::size_t g_KeyNum = 100000;
+
+/*
+ * Insert all keys, then erase them in another order.
+ * Return the nanoseconds per insert and per erase.
+ * */
+std::pair<double, double> run(std::pmr::memory_resource *const resource,
+                              const std::vector<int> &keys,
+                              const std::vector<int> &erase_keys) {
+  double insert_time = 0;
+  double erase_time = 0;
+  for (std::size_t round = 0; round < g_RoundNum; round++) {
+    std::pmr::map<int, int> map(resource);
+    auto start = std::chrono::steady_clock::now();
+    for (auto key : keys)
+      map.emplace(key, key);
+    auto middle = std::chrono::steady_clock::now();
+    for (auto key : erase_keys)
+      map.erase(key);
+    auto end = std::chrono::steady_clock::now();
+    insert_time += std::chrono::duration<double, std::nano>(middle - start)
+                       .count();
+    erase_time += std::chrono::duration<double, std::nano>(end - middle)
+                      .count();
+  }
+  const double op_num = static_cast<double>(g_RoundNum * keys.size());
+  return {insert_time / op_num, erase_time / op_num};
+}
+
+int main() {
+  std::vector<int> keys(g_KeyNum);
+  for (std::size_t i = 0; i < keys.size(); i++)
+    keys[i] = static_cast<int>(i);
+  std::vector<int> erase_keys(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  std::shuffle(erase_keys.begin(), erase_keys.end(), std::mt19937(7));
+
+  auto default_time = run(std::pmr::get_default_resource(), keys, erase_keys);
+  memory_pool::PoolMemoryResource resource;
+  auto pool_time = run(&resource, keys, erase_keys);
+
+  printf("%10s %16s %16s\n", "resource", "insert(ns/op)", "erase(ns/op)");
+  printf("%10s %16.2f %16.2f\n", "default", default_time.first,
+         default_time.second);
+  printf("%10s %16.2f %16.2f\n", "pool", pool_time.first, pool_time.second);
+  return 0;
+}
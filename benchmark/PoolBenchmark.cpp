@@ -0,0 +1,188 @@
+/*
+ * @author: Pei Mu
+ * @description: Benchmark suite of the memory pool against new/delete
+ * @data: 17th Oct 2026
+ * */
+
+#include "ExampleClasses.h"
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Usage: pool_benchmark [min_objects] [max_objects] [runs] [warmup]
+ * The object number goes from min_objects to max_objects by a factor of 10.
+ * Every case is run warmup times unmeasured, then runs times, and the median
+ * and the 99th percentile of the runs are reported in ns per
+ * construct/destroy pair, as CSV on stdout.
+ * */
+struct Options {
+  std::size_t min_objects = 100;
+  std::size_t max_objects = 1000000;
+  std::size_t runs = 31;
+  std::size_t warmup = 3;
+};
+
+enum class Pattern { lifo, fifo, random };
+
+const char *pattern_name(const Pattern &pattern) {
+  switch (pattern) {
+  case Pattern::lifo:
+    return "lifo";
+  case Pattern::fifo:
+    return "fifo";
+  default:
+    return "random";
+  }
+}
+
+/*
+ * CLOCK_MONOTONIC in nanoseconds, it never jumps and never wraps per second.
+ * */
+std::int64_t now_ns() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+/*
+ * The order to destroy the objects in.
+ * */
+std::vector<std::size_t> make_order(const Pattern &pattern,
+                                    const std::size_t &n) {
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  if (pattern == Pattern::lifo)
+    std::reverse(order.begin(), order.end());
+  else if (pattern == Pattern::random)
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  return order;
+}
+
+/*
+ * The allocators to compare, the pool is created beforehand and is not
+ * measured. Every object is constructed with the same arguments.
+ * */
+template <typename element_type> struct PoolCase {
+  static constexpr const char *name = "memory_pool";
+
+  template <typename... Args> element_type *construct(const Args &...args) {
+    return pool.construct(args...);
+  }
+  void destroy(element_type *const chunk) { pool.destroy(chunk); }
+
+  memory_pool::MemoryPool<element_type> pool{g_ChunkNum};
+};
+
+/*
+ * new of an array type returns a pointer to its first element, so an array
+ * object is allocated as an array of one.
+ * */
+template <typename element_type> struct NewDeleteCase {
+  static constexpr const char *name = "new_delete";
+
+  template <typename... Args> element_type *construct(const Args &...args) {
+    if constexpr (std::is_array<element_type>::value)
+      return new element_type[1]();
+    else
+      return new element_type(args...);
+  }
+  void destroy(element_type *const chunk) {
+    if constexpr (std::is_array<element_type>::value)
+      delete[] chunk;
+    else
+      delete chunk;
+  }
+};
+
+/*
+ * Construct all objects and destroy them in the given order.
+ * Return the nanoseconds per construct/destroy pair.
+ * */
+template <typename allocator_type, typename element_type, typename... Args>
+double run_once(allocator_type &allocator,
+                std::vector<element_type *> &chunks,
+                const std::vector<std::size_t> &order, const Args &...args) {
+  const std::int64_t start = now_ns();
+  for (auto &chunk : chunks)
+    chunk = allocator.construct(args...);
+  for (auto index : order)
+    allocator.destroy(chunks[index]);
+  return static_cast<double>(now_ns() - start) /
+         static_cast<double>(chunks.size());
+}
+
+/*
+ * The nearest-rank percentile of the sorted samples.
+ * */
+double percentile(const std::vector<double> &sorted, const double &p) {
+  auto rank = static_cast<std::size_t>(p / 100 * sorted.size() + 0.5);
+  rank = std::min(std::max<std::size_t>(rank, 1), sorted.size());
+  return sorted[rank - 1];
+}
+
+template <template <typename> class allocator_template, typename element_type,
+          typename... Args>
+void run_case(const Options &options, const char *type_name,
+              const Pattern &pattern, const std::size_t &n,
+              const Args &...args) {
+  allocator_template<element_type> allocator;
+  std::vector<element_type *> chunks(n);
+  const auto order = make_order(pattern, n);
+  for (std::size_t i = 0; i < options.warmup; i++)
+    run_once(allocator, chunks, order, args...);
+
+  std::vector<double> samples(options.runs);
+  for (auto &sample : samples)
+    sample = run_once(allocator, chunks, order, args...);
+  std::sort(samples.begin(), samples.end());
+  printf("%s,%s,%s,%zu,%zu,%.2f,%.2f,%.2f\n", type_name,
+         allocator_template<element_type>::name, pattern_name(pattern), n,
+         options.runs, samples.front(), percentile(samples, 50),
+         percentile(samples, 99));
+  fflush(stdout);
+}
+
+template <typename element_type, typename... Args>
+void run_type(const Options &options, const char *type_name,
+              const Args &...args) {
+  for (std::size_t n = options.min_objects; n <= options.max_objects;
+       n *= 10) {
+    for (auto pattern : {Pattern::lifo, Pattern::fifo, Pattern::random}) {
+      run_case<PoolCase, element_type>(options, type_name, pattern, n,
+                                       args...);
+      run_case<NewDeleteCase, element_type>(options, type_name, pattern, n,
+                                            args...);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  std::size_t *values[] = {&options.min_objects, &options.max_objects,
+                           &options.runs, &options.warmup};
+  for (int i = 1; i < argc && i <= 4; i++)
+    *values[i - 1] = std::strtoul(argv[i], nullptr, 10);
+  if (options.min_objects == 0 || options.runs == 0) {
+    fprintf(stderr,
+            "usage: %s [min_objects] [max_objects] [runs] [warmup]\n",
+            argv[0]);
+    return 1;
+  }
+
+  printf("type,allocator,pattern,objects,runs,min_ns,median_ns,p99_ns\n");
+  run_type<ByteType>(options, "ByteType");
+  run_type<PointerType>(options, "PointerType");
+  run_type<FixedStringType>(options, "FixedStringType");
+  run_type<Point>(options, "Point");
+  run_type<Base1>(options, "Base1");
+  run_type<Derived>(options, "Derived");
+  run_type<NoDefaultConstructor>(options, "NoDefaultConstructor", 42);
+  return 0;
+}
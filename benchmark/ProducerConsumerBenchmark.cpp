@@ -0,0 +1,251 @@
+/*
+ * @author: Pei Mu
+ * @description: Cross-thread producer/consumer benchmark of the pools
+ * @data: 17th Oct 2026
+ * */
+
+#include "ConcurrentMemoryPool.hpp"
+#include "LockFreeMemoryPool.hpp"
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+/*
+ * Usage: producer_consumer_benchmark [producers] [consumers] [objects]
+ * Every producer constructs objects and passes them to the consumers in turn,
+ * which check and destroy them, so nearly every object is destroyed by
+ * another thread than the one constructing it.
+ * */
+const std::size_t g_RingSize = 1024;
+// time one call out of g_SampleRate, the clock costs more than a pool call
+const std::size_t g_SampleRate = 16;
+
+struct Payload {
+  explicit Payload(const std::size_t &id_val) : id(id_val) {}
+
+  std::size_t id;
+  std::size_t data[3] = {};
+};
+
+/*
+ * The baseline: one MemoryPool shared by all threads behind a mutex.
+ * */
+class MutexMemoryPool {
+public:
+  Payload *construct(const std::size_t &id) {
+    std::lock_guard<std::mutex> guard(lock);
+    return pool.construct(id);
+  }
+
+  void destroy(Payload *const chunk) {
+    std::lock_guard<std::mutex> guard(lock);
+    pool.destroy(chunk);
+  }
+
+private:
+  std::mutex lock;
+  memory_pool::MemoryPool<Payload> pool;
+};
+
+class SystemMalloc {
+public:
+  Payload *construct(const std::size_t &id) {
+    return new (malloc(sizeof(Payload))) Payload(id);
+  }
+
+  void destroy(Payload *const chunk) {
+    chunk->~Payload();
+    free(chunk);
+  }
+};
+
+/*
+ * A single-producer single-consumer ring between each pair of threads.
+ * */
+class Ring {
+public:
+  bool push(Payload *const chunk) {
+    const std::size_t tail = write.load(std::memory_order_relaxed);
+    if (tail - read.load(std::memory_order_acquire) == g_RingSize)
+      return false;
+    slots[tail % g_RingSize] = chunk;
+    write.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  Payload *pop() {
+    const std::size_t head = read.load(std::memory_order_relaxed);
+    if (head == write.load(std::memory_order_acquire))
+      return nullptr;
+    Payload *const chunk = slots[head % g_RingSize];
+    read.store(head + 1, std::memory_order_release);
+    return chunk;
+  }
+
+private:
+  alignas(64) std::atomic<std::size_t> write{0};
+  alignas(64) std::atomic<std::size_t> read{0};
+  Payload *slots[g_RingSize] = {};
+};
+
+/*
+ * Reset the peak RSS of the process (Linux >= 4.0), and read it in KiB.
+ * */
+void reset_peak_rss() {
+  FILE *clear_refs = fopen("/proc/self/clear_refs", "w");
+  if (clear_refs == nullptr)
+    return;
+  fputs("5", clear_refs);
+  fclose(clear_refs);
+}
+
+long peak_rss() {
+  FILE *status = fopen("/proc/self/status", "r");
+  if (status == nullptr)
+    return -1;
+  char line[256];
+  long peak = -1;
+  while (fgets(line, sizeof(line), status) != nullptr) {
+    if (strncmp(line, "VmHWM:", 6) == 0) {
+      peak = strtol(line + 6, nullptr, 10);
+      break;
+    }
+  }
+  fclose(status);
+  return peak;
+}
+
+double percentile(std::vector<double> &samples, const double &p) {
+  if (samples.empty())
+    return 0;
+  auto rank = static_cast<std::size_t>(p / 100 * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+  return samples[rank];
+}
+
+template <typename pool_type>
+void run(const char *name, const std::size_t &producers,
+         const std::size_t &consumers, const std::size_t &objects) {
+  auto pool = std::make_unique<pool_type>();
+  std::vector<std::unique_ptr<Ring>> rings(producers * consumers);
+  for (auto &ring : rings)
+    ring = std::make_unique<Ring>();
+  std::vector<std::vector<double>> construct_times(producers);
+  std::vector<std::vector<double>> destroy_times(consumers);
+  std::atomic<std::size_t> running_producers{producers};
+  std::atomic<std::size_t> errors{0};
+
+  reset_peak_rss();
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t p = 0; p < producers; p++) {
+    threads.emplace_back([&, p]() {
+      auto &times = construct_times[p];
+      for (std::size_t i = 0; i < objects; i++) {
+        Payload *chunk;
+        if (i % g_SampleRate == 0) {
+          auto construct_start = std::chrono::steady_clock::now();
+          chunk = pool->construct(i);
+          times.emplace_back(std::chrono::duration<double, std::nano>(
+                                 std::chrono::steady_clock::now() -
+                                 construct_start)
+                                 .count());
+        } else {
+          chunk = pool->construct(i);
+        }
+        Ring &ring = *rings[p * consumers + i % consumers];
+        while (!ring.push(chunk))
+          std::this_thread::yield();
+      }
+      running_producers.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  for (std::size_t c = 0; c < consumers; c++) {
+    threads.emplace_back([&, c]() {
+      auto &times = destroy_times[c];
+      std::size_t destroyed = 0;
+      while (true) {
+        // read the flag first, so nothing pushed before it is missed
+        const bool done =
+            running_producers.load(std::memory_order_acquire) == 0;
+        bool found = false;
+        for (std::size_t p = 0; p < producers; p++) {
+          Ring &ring = *rings[p * consumers + c];
+          while (Payload *chunk = ring.pop()) {
+            found = true;
+            if (chunk->id % consumers != c)
+              errors.fetch_add(1, std::memory_order_relaxed);
+            if (destroyed++ % g_SampleRate == 0) {
+              auto destroy_start = std::chrono::steady_clock::now();
+              pool->destroy(chunk);
+              times.emplace_back(std::chrono::duration<double, std::nano>(
+                                     std::chrono::steady_clock::now() -
+                                     destroy_start)
+                                     .count());
+            } else {
+              pool->destroy(chunk);
+            }
+          }
+        }
+        if (done && !found)
+          break;
+        if (!found)
+          std::this_thread::yield();
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  const long rss = peak_rss();
+
+  std::vector<double> construct_samples, destroy_samples;
+  for (auto &times : construct_times)
+    construct_samples.insert(construct_samples.end(), times.begin(),
+                             times.end());
+  for (auto &times : destroy_times)
+    destroy_samples.insert(destroy_samples.end(), times.begin(), times.end());
+  printf("%10s %14.2f %12.0f %12.0f %12.0f %12.0f %14ld%s\n", name,
+         static_cast<double>(producers * objects) / seconds / 1e6,
+         percentile(construct_samples, 50), percentile(construct_samples, 99),
+         percentile(destroy_samples, 50), percentile(destroy_samples, 99),
+         rss, errors.load() ? " (errors)" : "");
+}
+
+int main(int argc, char **argv) {
+  std::size_t producers = 2, consumers = 2, objects = 1000000;
+  if (argc > 1)
+    producers = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2)
+    consumers = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3)
+    objects = std::strtoul(argv[3], nullptr, 10);
+  if (producers == 0 || consumers == 0) {
+    fprintf(stderr, "usage: %s [producers] [consumers] [objects]\n", argv[0]);
+    return 1;
+  }
+
+  printf("%zu producers, %zu consumers, %zu objects per producer\n", producers,
+         consumers, objects);
+  printf("%10s %14s %12s %12s %12s %12s %14s\n", "pool", "Mops/s",
+         "ctor p50(ns)", "ctor p99(ns)", "dtor p50(ns)", "dtor p99(ns)",
+         "peak RSS(KiB)");
+  run<SystemMalloc>("malloc", producers, consumers, objects);
+  run<MutexMemoryPool>("mutex", producers, consumers, objects);
+  run<memory_pool::LockFreeMemoryPool<Payload>>("lock-free", producers,
+                                                consumers, objects);
+  run<memory_pool::ConcurrentMemoryPool<Payload>>("magazine", producers,
+                                                  consumers, objects);
+  return 0;
+}
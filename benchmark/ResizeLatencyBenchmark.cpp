@@ -0,0 +1,77 @@
+/*
+ * @author: Pei Mu
+ * @description: Latency spike of malloc_need_resize(), eager vs. lazy
+ * @data: 16th Oct 2026
+ * */
+
+#include "MemoryPool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
+const std::size_t g_ChunkNum = 1 << 16;
+const std::size_t g_ObjectNum = 1 << 20;
+
+struct Payload {
+  std::size_t data[8];
+};
+
+/*
+ * The resident set size in KiB.
+ * */
+long resident_size() {
+  long pages = 0;
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr)
+    return 0;
+  if (fscanf(statm, "%*s %ld", &pages) != 1)
+    pages = 0;
+  fclose(statm);
+  return pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+double elapsed_us(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void run(const char *name, const bool &lazy_segregation) {
+  long rss_before = resident_size();
+  auto start = std::chrono::steady_clock::now();
+  auto *mp = new memory_pool::MemoryPool<Payload>(g_ChunkNum, 0,
+                                                  lazy_segregation);
+  std::vector<Payload *> chunks;
+  chunks.reserve(g_ObjectNum);
+  chunks.emplace_back(mp->construct());
+  double first_time = elapsed_us(start);
+  long first_rss = resident_size() - rss_before;
+
+  // the slowest construct() is the one that resizes the pool
+  double max_time = 0;
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 1; i < g_ObjectNum; i++) {
+    auto construct_start = std::chrono::steady_clock::now();
+    chunks.emplace_back(mp->construct());
+    double construct_time = elapsed_us(construct_start);
+    if (construct_time > max_time)
+      max_time = construct_time;
+  }
+  double total_time = elapsed_us(start);
+
+  printf("%8s %18.2f %16ld %18.2f %14.2f\n", name, first_time, first_rss,
+         max_time, total_time / 1000);
+  for (auto chunk : chunks)
+    mp->destroy(chunk);
+  delete mp;
+}
+
+int main() {
+  printf("%8s %18s %16s %18s %14s\n", "mode", "first alloc(us)",
+         "first RSS(KiB)", "max construct(us)", "total(ms)");
+  run("eager", false);
+  run("lazy", true);
+  return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * @author: Pei Mu
+ * @description: Size-class pool vs. glibc malloc across a mix of sizes
+ * @data: 16th Oct 2026
+ * */
+
+#include "SizeClassPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+const std::size_t g_RoundNum = 200;
+const std::size_t g_ObjectNum = 10000;
+
+/*
+ * Small sizes dominate, as for most object types.
+ * */
+std::vector<std::size_t> make_sizes() {
+  std::mt19937 gen(42);
+  std::geometric_distribution<std::size_t> small(1.0 / 48);
+  std::uniform_int_distribution<std::size_t> large(1, 1024);
+  std::vector<std::size_t> sizes(g_ObjectNum);
+  for (auto &size : sizes)
+    size = gen() % 8 == 0 ? large(gen) : small(gen) % 1024 + 1;
+  return sizes;
+}
+
+/*
+ * Allocate every size, touch it, then free the chunks in a shuffled order.
+ * Return the nanoseconds per allocate/deallocate pair.
+ * */
+template <typename allocate_type, typename deallocate_type>
+double run(const std::vector<std::size_t> &sizes,
+           const std::vector<std::size_t> &order, allocate_type allocate,
+           deallocate_type deallocate) {
+  std::vector<char *> chunks(sizes.size());
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t round = 0; round < g_RoundNum; round++) {
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+      chunks[i] = static_cast<char *>(allocate(sizes[i]));
+      chunks[i][0] = static_cast<char>(i);
+    }
+    for (auto i : order)
+      deallocate(chunks[i], sizes[i]);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(g_RoundNum * sizes.size());
+}
+
+int main() {
+  auto sizes = make_sizes();
+  std::vector<std::size_t> order(sizes.size());
+  for (std::size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+  memory_pool::SizeClassPool pool;
+  double pool_time = run(
+      sizes, order, [&pool](std::size_t size) { return pool.allocate(size); },
+      [&pool](void *chunk, std::size_t size) { pool.deallocate(chunk, size); });
+  double malloc_time = run(
+      sizes, order, [](std::size_t size) { return malloc(size); },
+      [](void *chunk, std::size_t) { free(chunk); });
+
+  printf("%16s %16s\n", "malloc(ns/op)", "size class(ns/op)");
+  printf("%16.2f %16.2f\n", malloc_time, pool_time);
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * @author: Pei Mu
+ * @description: Random traversal of pooled objects, 4K pages vs. huge pages
+ * @data: 17th Oct 2026
+ * */
+
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <linux/perf_event.h>
+#include <random>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+const std::size_t g_ObjectNum = 1 << 22;
+const std::size_t g_ChunkNum = 1 << 16;
+
+struct Node {
+  Node *next;
+  std::size_t value[7];
+};
+
+/*
+ * Count the dTLB load misses of this thread with perf_event_open.
+ * Return -1 if the counter is not available.
+ * */
+class TlbMissCounter {
+public:
+  TlbMissCounter() {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  ~TlbMissCounter() {
+    if (fd >= 0)
+      close(fd);
+  }
+
+  void start() {
+    if (fd < 0)
+      return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  long long stop() {
+    if (fd < 0)
+      return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(fd, &count, sizeof(count)) != sizeof(count))
+      return -1;
+    return count;
+  }
+
+private:
+  int fd;
+};
+
+/*
+ * Link all objects in a random order, and chase the pointers, so that
+ * nearly every access lands on another page.
+ * */
+template <typename block_provider>
+void run(const char *name, const block_provider &provider) {
+  memory_pool::MemoryPool<Node, block_provider> mp(g_ChunkNum, 0, false,
+                                                   provider);
+  std::vector<Node *> nodes(g_ObjectNum);
+  for (auto &node : nodes)
+    node = mp.construct();
+  std::shuffle(nodes.begin(), nodes.end(), std::mt19937(42));
+  for (std::size_t i = 0; i < g_ObjectNum; i++) {
+    nodes[i]->next = nodes[(i + 1) % g_ObjectNum];
+    nodes[i]->value[0] = i;
+  }
+
+  TlbMissCounter counter;
+  std::size_t sum = 0;
+  Node *iter = nodes[0];
+  counter.start();
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < g_ObjectNum; i++) {
+    sum += iter->value[0];
+    iter = iter->next;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  long long misses = counter.stop();
+
+  printf("%18s %14.2f %18.3f %10zu\n", name,
+         std::chrono::duration<double, std::nano>(elapsed).count() /
+             g_ObjectNum,
+         misses < 0 ? -1.0 : static_cast<double>(misses) / g_ObjectNum,
+         sum % 10);
+  mp.destroy_n(nodes.data(), nodes.size());
+}
+
+int main() {
+  using memory_pool::MmapBlockProvider;
+  printf("%18s %14s %18s %10s\n", "provider", "access(ns)",
+         "dTLB miss/access", "checksum");
+  run("malloc", memory_pool::MallocBlockProvider());
+  run("mmap 4K", MmapBlockProvider(MmapBlockProvider::populate));
+  run("mmap THP", MmapBlockProvider(MmapBlockProvider::transparent_huge |
+                                    MmapBlockProvider::populate));
+  run("mmap MAP_HUGETLB", MmapBlockProvider(MmapBlockProvider::huge_tlb |
+                                            MmapBlockProvider::populate));
+  return 0;
+}
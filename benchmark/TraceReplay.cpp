@@ -0,0 +1,343 @@
+/*
+ * @author: Pei Mu
+ * @description: Replay an allocation trace against the pools and malloc
+ * @data: 17th Oct 2026
+ * */
+
+#include "MemoryPool.hpp"
+#include "PoolStats.hpp"
+#include "SizeClassPool.hpp"
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <memory>
+#include <utility>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+/*
+ * Usage: trace_replay <trace> [chunks_num] [max_chunks]
+ * The trace written by TraceRecorder is replayed in the order of the events
+ * of all its pools and threads (see TraceRecord::sequence) on one thread,
+ * against malloc, the size-class pool and one MemoryPool per chunk size
+ * created with chunks_num and max_chunks, so both can be tuned on a real
+ * trace. Every allocator is replayed in a child process, which reports the
+ * time, its peak RSS, and the fragmentation at the peak of the live bytes:
+ * 1 - live bytes / bytes reserved by the allocator.
+ * */
+
+/*
+ * A construct or destroy of the object id, the ids are dense so the replay
+ * keeps the objects in a plain vector.
+ * */
+struct Op {
+  bool construct;
+  std::uint32_t size;
+  std::size_t id;
+};
+
+struct Trace {
+  std::vector<Op> ops;
+  std::size_t object_num = 0;
+  std::size_t thread_num = 0;
+  // the live bytes reach their peak after ops[peak_op]
+  std::size_t peak_op = 0;
+  std::size_t peak_live = 0;
+};
+
+/*
+ * Give every construct a new id, and every destroy the id of the last
+ * construct at its address. The destroys of objects constructed before the
+ * trace was started are dropped.
+ * The records are sorted by address instead of looked up in a hash map, so
+ * the big temporaries are mmapped and the heap stays clean for malloc.
+ * */
+Trace make_trace(const std::vector<memory_pool::TraceRecord> &records) {
+  std::vector<std::pair<std::uint64_t, std::size_t>> by_object(
+      records.size());
+  for (std::size_t i = 0; i < records.size(); i++)
+    by_object[i] = {records[i].object, i};
+  std::sort(by_object.begin(), by_object.end());
+
+  Trace trace;
+  std::vector<std::size_t> ids(records.size(), SIZE_MAX);
+  for (std::size_t i = 0; i < by_object.size(); i++) {
+    const std::size_t index = by_object[i].second;
+    if (records[index].op == memory_pool::TraceOp::construct) {
+      ids[index] = trace.object_num++;
+    } else if (i > 0 && by_object[i - 1].first == by_object[i].first) {
+      const std::size_t last = by_object[i - 1].second;
+      if (records[last].op == memory_pool::TraceOp::construct)
+        ids[index] = ids[last];
+    }
+  }
+
+  trace.ops.reserve(records.size());
+  std::size_t live = 0;
+  for (std::size_t i = 0; i < records.size(); i++) {
+    const auto &record = records[i];
+    trace.thread_num =
+        std::max<std::size_t>(trace.thread_num, record.thread + 1);
+    if (ids[i] == SIZE_MAX)
+      continue;
+    const bool construct = record.op == memory_pool::TraceOp::construct;
+    trace.ops.push_back({construct, record.size, ids[i]});
+    if (!construct) {
+      live -= record.size;
+      continue;
+    }
+    live += record.size;
+    if (live > trace.peak_live) {
+      trace.peak_live = live;
+      trace.peak_op = trace.ops.size() - 1;
+    }
+  }
+  return trace;
+}
+
+/*
+ * The allocators to replay against, reserved() is the memory taken from the
+ * system as counted by the allocator itself, or 0 if it does not know.
+ * */
+class SystemMalloc {
+public:
+  static constexpr const char *name = "malloc";
+
+  void *allocate(const std::size_t &size) { return malloc(size); }
+  void deallocate(void *const chunk, const std::size_t &) { free(chunk); }
+  std::size_t reserved() const {
+#if defined(__GLIBC__) &&                                                      \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return info.arena + info.hblkhd;
+#else
+    return 0;
+#endif
+  }
+};
+
+class SizeClassReplay {
+public:
+  static constexpr const char *name = "size_class";
+
+  void *allocate(const std::size_t &size) { return pool.allocate(size); }
+  void deallocate(void *const chunk, const std::size_t &size) {
+    pool.deallocate(chunk, size);
+  }
+  std::size_t reserved() const { return 0; }
+
+private:
+  memory_pool::SizeClassPool pool;
+};
+
+/*
+ * The chunk sizes of a trace are only known at run time, so a MemoryPool is
+ * instantiated for every multiple of 8 up to max_pool_size and created on
+ * the first use of its size. Bigger chunks go to malloc.
+ * */
+constexpr std::size_t max_pool_size = 1024;
+
+class SizedPool {
+public:
+  virtual ~SizedPool() = default;
+  virtual void *allocate() = 0;
+  virtual void deallocate(void *const chunk) = 0;
+  virtual std::size_t reserved() const = 0;
+};
+
+template <std::size_t size> class FixedSizedPool : public SizedPool {
+  struct Chunk {
+    alignas(8) char data[size];
+  };
+
+public:
+  FixedSizedPool(const std::size_t &chunks_num, const std::size_t &max_chunks)
+      : pool(chunks_num, max_chunks) {}
+
+  void *allocate() override { return pool.malloc_chunk(); }
+  void deallocate(void *const chunk) override { pool.free_chunk(chunk); }
+  std::size_t reserved() const override {
+    return pool.get_stats().reserved_bytes();
+  }
+
+private:
+  memory_pool::RawMemoryPool<Chunk, memory_pool::MallocBlockProvider,
+                             memory_pool::PoolStats>
+      pool;
+};
+
+typedef std::unique_ptr<SizedPool> (*PoolFactory)(const std::size_t &,
+                                                  const std::size_t &);
+
+template <std::size_t... index>
+constexpr std::array<PoolFactory, sizeof...(index)>
+make_pool_factories(std::index_sequence<index...>) {
+  return {{[](const std::size_t &chunks_num,
+              const std::size_t &max_chunks) -> std::unique_ptr<SizedPool> {
+    return std::make_unique<FixedSizedPool<(index + 1) * 8>>(chunks_num,
+                                                             max_chunks);
+  }...}};
+}
+
+constexpr auto pool_factories =
+    make_pool_factories(std::make_index_sequence<max_pool_size / 8>());
+
+class MemoryPoolReplay {
+public:
+  static constexpr const char *name = "memory_pool";
+
+  MemoryPoolReplay(const std::size_t &chunks_num_val,
+                   const std::size_t &max_chunks_val)
+      : chunks_num(chunks_num_val), max_chunks(max_chunks_val) {}
+
+  void *allocate(const std::size_t &size) {
+    if (size > max_pool_size || size % 8 != 0)
+      return malloc(size);
+    auto &pool = pools[size / 8 - 1];
+    if (!pool)
+      pool = pool_factories[size / 8 - 1](chunks_num, max_chunks);
+    return pool->allocate();
+  }
+
+  void deallocate(void *const chunk, const std::size_t &size) {
+    if (size > max_pool_size || size % 8 != 0)
+      free(chunk);
+    else
+      pools[size / 8 - 1]->deallocate(chunk);
+  }
+
+  std::size_t reserved() const {
+    std::size_t bytes = 0;
+    for (const auto &pool : pools) {
+      if (pool)
+        bytes += pool->reserved();
+    }
+    return bytes;
+  }
+
+private:
+  std::size_t chunks_num;
+  std::size_t max_chunks;
+  std::array<std::unique_ptr<SizedPool>, max_pool_size / 8> pools;
+};
+
+/*
+ * The peak RSS of the process in KiB.
+ * */
+long peak_rss() {
+  FILE *status = fopen("/proc/self/status", "r");
+  if (status == nullptr)
+    return -1;
+  char line[256];
+  long peak = -1;
+  while (fgets(line, sizeof(line), status) != nullptr) {
+    if (strncmp(line, "VmHWM:", 6) == 0) {
+      peak = strtol(line + 6, nullptr, 10);
+      break;
+    }
+  }
+  fclose(status);
+  return peak;
+}
+
+template <typename allocator_type>
+void run_ops(allocator_type &allocator, const std::vector<Op> &ops,
+             const std::size_t &begin, const std::size_t &end,
+             std::vector<void *> &objects) {
+  for (std::size_t i = begin; i < end; i++) {
+    const Op &op = ops[i];
+    if (op.construct) {
+      // write the object like its constructor, so its pages count in the RSS
+      objects[op.id] = memset(allocator.allocate(op.size), 0, op.size);
+    } else {
+      allocator.deallocate(objects[op.id], op.size);
+      objects[op.id] = nullptr;
+    }
+  }
+}
+
+/*
+ * Replay the trace in a child process, so the heap left by another
+ * allocator does not hide the peak RSS of this one. The clock is stopped
+ * while reserved() is read at the peak.
+ * */
+template <typename allocator_type, typename... Args>
+void replay(const Trace &trace, const Args &...args) {
+  fflush(stdout);
+  const pid_t child = fork();
+  if (child != 0) {
+    waitpid(child, nullptr, 0);
+    return;
+  }
+
+  std::vector<void *> objects(trace.object_num);
+  std::unique_ptr<allocator_type> allocator =
+      std::make_unique<allocator_type>(args...);
+  const std::size_t peak_end = std::min(trace.peak_op + 1, trace.ops.size());
+  // malloc also counts the heap of the trace
+  const std::size_t reserved_before = allocator->reserved();
+  auto start = std::chrono::steady_clock::now();
+  run_ops(*allocator, trace.ops, 0, peak_end, objects);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  const std::size_t reserved = allocator->reserved() - reserved_before;
+  start = std::chrono::steady_clock::now();
+  run_ops(*allocator, trace.ops, peak_end, trace.ops.size(), objects);
+  elapsed += std::chrono::steady_clock::now() - start;
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+
+  const double peak_live_kib = static_cast<double>(trace.peak_live) / 1024;
+  printf("%12s %12.3f %10.2f %14ld %14.0f", allocator_type::name,
+         seconds * 1e3, seconds * 1e9 / static_cast<double>(trace.ops.size()),
+         peak_rss(), peak_live_kib);
+  if (reserved == 0)
+    printf(" %14s %9s\n", "-", "-");
+  else
+    printf(" %14zu %8.1f%%\n", reserved / 1024,
+           100 * (1 - static_cast<double>(trace.peak_live) / reserved));
+  fflush(stdout);
+  _exit(0);
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <trace> [chunks_num] [max_chunks]\n", argv[0]);
+    return 1;
+  }
+  std::size_t chunks_num = 32, max_chunks = 0;
+  if (argc > 2)
+    chunks_num = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3)
+    max_chunks = std::strtoul(argv[3], nullptr, 10);
+  if (chunks_num == 0) {
+    fprintf(stderr, "chunks_num must be positive\n");
+    return 1;
+  }
+
+  std::vector<memory_pool::TraceRecord> records;
+  if (!memory_pool::read_trace(argv[1], records)) {
+    fprintf(stderr, "%s is not a trace of version %u\n", argv[1],
+            memory_pool::trace_version);
+    return 1;
+  }
+  const Trace trace = make_trace(records);
+  records = {};
+
+  printf("%zu ops, %zu objects, %zu threads, chunks_num %zu, max_chunks "
+         "%zu\n",
+         trace.ops.size(), trace.object_num, trace.thread_num, chunks_num,
+         max_chunks);
+  printf("%12s %12s %10s %14s %14s %14s %9s\n", "allocator", "time(ms)",
+         "ns/op", "peak RSS(KiB)", "peak live(KiB)", "reserved(KiB)",
+         "frag");
+  replay<SystemMalloc>(trace);
+  replay<SizeClassReplay>(trace);
+  replay<MemoryPoolReplay>(trace, chunks_num, max_chunks);
+  return 0;
+}
@@ -22,13 +22,13 @@ void printTimeSpec(timespec t, const char *prefix) {
 
 timespec tic() {
   timespec start_time;
-  clock_gettime(CLOCK_REALTIME, &start_time);
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
   return start_time;
 }
 
 timespec toc(timespec *start_time, const char *prefix) {
   timespec current_time;
-  clock_gettime(CLOCK_REALTIME, &current_time);
+  clock_gettime(CLOCK_MONOTONIC, &current_time);
 	auto time_diff = diff(*start_time, current_time);
   printTimeSpec(time_diff, prefix);
   *start_time = current_time;
@@ -62,7 +62,18 @@ int main() {
 
 	sleep(1);
 	auto no_default_construct_test = PerformanceTester<NoDefaultConstructor>();
-	no_default_construct_test.test();
+	no_default_construct_test.test(3);
+
+	sleep(1);
+	auto multi_args_construct_test = PerformanceTester<TestClass>();
+	multi_args_construct_test.test(1, 2, 3);
+
+	// batch construct_n/destroy_n against single construct/destroy
+	sleep(1);
+	struct_type_test.test_batch();
+
+	sleep(1);
+	derived_class_test.test_batch();
 
 	return 0;
 }
@@ -81,10 +81,16 @@ private:
 	int number;
 };
 
+// A class constructed from several arguments
 class TestClass
 {
  public:
-	TestClass(int num1, int num2, int num3)
+	TestClass(int num1, int num2, int num3) : number1(num1), number2(num2), number3(num3) {}
+
+	int GetSum() const { return number1 + number2 + number3; }
+
+ private:
+	int number1, number2, number3;
 };
 
 
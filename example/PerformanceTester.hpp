@@ -19,18 +19,22 @@ void printTimeSpec(timespec t, const char* prefix);
 timespec tic( );
 timespec toc(timespec* start_time, const char* prefix );
 
-template <typename element_type, std::size_t N=3>
+template <typename element_type>
 class PerformanceTester {
  public:
 	PerformanceTester() = default;
 	~PerformanceTester() = default;
 
-	void test() {
+	/*
+	 * The arguments are passed to the constructor of each object.
+	 * */
+	template <typename... Args>
+	void test(const Args &...args) {
 		std::vector<element_type *> ele_mp_vec;
-		timespec timer = tic();
 		auto mp = memory_pool::MemoryPool<element_type>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+		timespec timer = tic();
 		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum; chunk_id++) {
-			auto memory_chunk = mp.construct();
+			auto memory_chunk = mp.construct(args...);
 			ele_mp_vec.emplace_back(memory_chunk);
 			// do something with the new allocated memory
 		}
@@ -39,26 +43,73 @@ class PerformanceTester {
 		}
 		auto mp_time = toc(&timer, "computation delay of memory pool");
 
-		std::vector<void *> ele_default_vec;
+		std::vector<decltype(system_new(args...))> ele_default_vec;
 		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum; chunk_id++) {
-			if constexpr (std::is_default_constructible<element_type>::value) {
-				auto memory = new element_type();
-				ele_default_vec.emplace_back(memory);
-			} else {
-				auto memory = new element_type(N);
-				ele_default_vec.emplace_back(memory);
-			}
+			auto memory = system_new(args...);
+			ele_default_vec.emplace_back(memory);
 			// do something with the new allocated memory
 		}
 		for (auto &ele : ele_default_vec) {
-			memory_pool::destroy_element(ele);
+			system_delete(ele);
 		}
 		auto default_time = toc(&timer, "computation delay of system new/delete");
-		long time_diff = default_time.tv_nsec - mp_time.tv_nsec;
-		long system_time = default_time.tv_nsec;
-		double speed_up = (double)time_diff / (double)system_time * 100;
+		double mp_ns = mp_time.tv_sec * 1e9 + mp_time.tv_nsec;
+		double system_ns = default_time.tv_sec * 1e9 + default_time.tv_nsec;
+		double speed_up = (system_ns - mp_ns) / system_ns * 100;
 		std::cout << typeid(element_type).name() << " speed up: " << speed_up << "%" << std::endl;
 	}
+
+	/*
+	 * Compare the throughput per object of construct()/destroy()
+	 * against construct_n()/destroy_n() with the same pool.
+	 * */
+	template <typename... Args>
+	void test_batch(const Args &...args) {
+		auto mp = memory_pool::MemoryPool<element_type>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+		std::vector<element_type *> ele_mp_vec(g_ChunkNum);
+		timespec timer = tic();
+		for (std::size_t round = 0; round < g_BatchRoundNum; round++) {
+			for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum; chunk_id++)
+				ele_mp_vec[chunk_id] = mp.construct(args...);
+			for (auto &ele : ele_mp_vec)
+				mp.destroy(ele);
+		}
+		auto single_time = toc(&timer, "computation delay of construct/destroy");
+
+		for (std::size_t round = 0; round < g_BatchRoundNum; round++) {
+			mp.construct_n(ele_mp_vec.data(), g_ChunkNum, args...);
+			mp.destroy_n(ele_mp_vec.data(), g_ChunkNum);
+		}
+		auto batch_time = toc(&timer, "computation delay of construct_n/destroy_n");
+
+		double object_num = (double)g_BatchRoundNum * g_ChunkNum;
+		double single_ns = (single_time.tv_sec * 1e9 + single_time.tv_nsec) / object_num;
+		double batch_ns = (batch_time.tv_sec * 1e9 + batch_time.tv_nsec) / object_num;
+		std::cout << typeid(element_type).name() << " per object: " << single_ns << "ns single, "
+		          << batch_ns << "ns batch" << std::endl;
+	}
+
+	static constexpr std::size_t g_BatchRoundNum = 1000;
+
+ private:
+	/*
+	 * new/delete of element_type, the array types need new[]/delete[].
+	 * */
+	template <typename... Args>
+	static auto system_new(const Args &...args) {
+		if constexpr (std::is_array<element_type>::value)
+			return new element_type;
+		else
+			return new element_type(args...);
+	}
+
+	template <typename pointer_type>
+	static void system_delete(pointer_type ele) {
+		if constexpr (std::is_array<element_type>::value)
+			delete[] ele;
+		else
+			delete ele;
+	}
 };
 
 #endif //PERFORMANCE_TESTER_H
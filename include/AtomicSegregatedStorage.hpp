@@ -0,0 +1,114 @@
+/*
+ * @author: Pei Mu
+ * @description: Lock-free version of the simple segregated storage
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef ATOMIC_SEGREGATED_STORAGE_H
+#define ATOMIC_SEGREGATED_STORAGE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace memory_pool {
+/*
+ * The free list of the simple segregated storage as a Treiber stack.
+ * Ref: R. K. Treiber, "Systems Programming: Coping with Parallelism", 1986.
+ *
+ * To avoid the ABA problem, free_memory packs a generation tag into the
+ * spare upper 16 bits of the chunk address (user space addresses only use
+ * 48 bits on x86-64 and AArch64), and every successful update bumps the tag.
+ * Chunks are never given back to the system while the storage is in use,
+ * so reading the next node of a chunk that has just been popped by another
+ * thread is harmless: the tag makes that compare-and-swap fail.
+ * */
+class AtomicSegregatedStorage {
+public:
+  AtomicSegregatedStorage() : free_memory(0) {}
+
+protected:
+  /*
+   * Malloc method of the lock-free segregated storage.
+   * Return nullptr if the free list is empty.
+   * */
+  void *memory_pool_malloc() {
+    std::uintptr_t head = free_memory.load(std::memory_order_acquire);
+    while (address_of(head) != nullptr) {
+      std::uintptr_t next =
+          pack(load_next(address_of(head)), tag_of(head) + 1);
+      if (free_memory.compare_exchange_weak(head, next,
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire))
+        return address_of(head);
+    }
+    return nullptr;
+  }
+
+  /*
+   * Free method of the lock-free segregated storage.
+   * */
+  void memory_pool_free(void *const chunk) {
+    memory_pool_free_chain(chunk, chunk);
+  }
+
+  /*
+   * Push a linked list of chunks from first to last at once.
+   * */
+  void memory_pool_free_chain(void *const first, void *const last) {
+    std::uintptr_t head = free_memory.load(std::memory_order_relaxed);
+    std::uintptr_t next;
+    do {
+      store_next(last, address_of(head));
+      next = pack(first, tag_of(head) + 1);
+    } while (!free_memory.compare_exchange_weak(head, next,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+  }
+
+  bool empty() const {
+    return address_of(free_memory.load(std::memory_order_relaxed)) == nullptr;
+  }
+
+  /*
+   * The next node is read and written concurrently, use the atomic builtins
+   * on the plain pointer stored in the chunk.
+   * */
+  static void *load_next(void *const chunk) {
+    return __atomic_load_n(static_cast<void **>(chunk), __ATOMIC_RELAXED);
+  }
+
+  static void store_next(void *const chunk, void *const next) {
+    __atomic_store_n(static_cast<void **>(chunk), next, __ATOMIC_RELAXED);
+  }
+
+  /*
+   * The tagged pointer of the first trunk.
+   * */
+  std::atomic<std::uintptr_t> free_memory;
+
+private:
+  static_assert(sizeof(void *) == sizeof(std::uint64_t),
+                "the tagged free list needs 64-bit pointers");
+
+  static constexpr unsigned address_bits = 48;
+  static constexpr std::uintptr_t address_mask =
+      (std::uintptr_t(1) << address_bits) - 1;
+
+  static std::uintptr_t pack(void *const ptr, const std::uintptr_t &tag) {
+    auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    assert((address & ~address_mask) == 0);
+    return address | (tag << address_bits);
+  }
+
+  static void *address_of(const std::uintptr_t &tagged) {
+    return reinterpret_cast<void *>(tagged & address_mask);
+  }
+
+  static std::uintptr_t tag_of(const std::uintptr_t &tagged) {
+    return tagged >> address_bits;
+  }
+};
+} // namespace memory_pool
+
+#endif // ATOMIC_SEGREGATED_STORAGE_H
@@ -0,0 +1,149 @@
+/*
+ * @author: Pei Mu
+ * @description: Providers of the memory blocks of the memory pool
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef BLOCK_PROVIDER_H
+#define BLOCK_PROVIDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace memory_pool {
+/*
+ * A block provider hands out the memory blocks of a pool with
+ *  void *allocate(const std::size_t &size);
+ *  void deallocate(void *block, const std::size_t &size);
+ * where size is the same in both calls. allocate returns nullptr on failure.
+ * A provider aligning its blocks more than malloc tells it with
+ *  static constexpr std::size_t block_alignment;
+ * */
+
+/*
+ * The alignment of the blocks of block_provider, the one of malloc if the
+ * provider doesn't tell.
+ * */
+template <typename block_provider, typename = void>
+struct block_alignment_of
+    : std::integral_constant<std::size_t, alignof(std::max_align_t)> {};
+
+template <typename block_provider>
+struct block_alignment_of<
+    block_provider, std::void_t<decltype(block_provider::block_alignment)>>
+    : std::integral_constant<std::size_t, block_provider::block_alignment> {};
+
+/*
+ * The default provider, blocks come from malloc.
+ * */
+struct MallocBlockProvider {
+  void *allocate(const std::size_t &size) { return malloc(size); }
+
+  void deallocate(void *const block, const std::size_t &) { free(block); }
+};
+
+/*
+ * Blocks are mapped from the system directly, and the size is rounded up to
+ * whole pages. So a pool with millions of small objects can be backed by
+ * huge pages to reduce the TLB misses:
+ *  huge_tlb: map from the reserved huge pages (MAP_HUGETLB), and fall back
+ *            to normal pages if there are not enough of them;
+ *  transparent_huge: align the block to the huge page size and ask for
+ *                    transparent huge pages (madvise(MADV_HUGEPAGE));
+ *  populate: pre-fault the pages when the block is mapped (MAP_POPULATE),
+ *            so the first touch of each page doesn't page-fault later.
+ * With huge pages, choose the chunk number of the pool to make the blocks
+ * close to a multiple of huge_page_size, the rest of the last page is wasted.
+ * */
+class MmapBlockProvider {
+public:
+  enum Flags : unsigned {
+    none = 0,
+    huge_tlb = 1u << 0,
+    transparent_huge = 1u << 1,
+    populate = 1u << 2,
+  };
+
+  static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+  // the blocks are mapped, so they are aligned to at least a small page
+  static constexpr std::size_t block_alignment = 4096;
+
+  explicit MmapBlockProvider(const unsigned &flags_val = none)
+      : flags(flags_val) {}
+
+  void *allocate(const std::size_t &size) {
+    const std::size_t length = mapped_size(size);
+    int map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+    if (flags & populate)
+      map_flags |= MAP_POPULATE;
+#endif
+#ifdef MAP_HUGETLB
+    if (flags & huge_tlb) {
+      void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       map_flags | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED)
+        return ptr;
+    }
+#endif
+    if (flags & transparent_huge)
+      return map_aligned(length, flags & populate);
+    void *ptr =
+        mmap(nullptr, length, PROT_READ | PROT_WRITE, map_flags, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  void deallocate(void *const block, const std::size_t &size) {
+    munmap(block, mapped_size(size));
+  }
+
+  /*
+   * The size really mapped for a block of the given size.
+   * */
+  std::size_t mapped_size(const std::size_t &size) const {
+    const std::size_t page_size =
+        (flags & (huge_tlb | transparent_huge))
+            ? huge_page_size
+            : static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (size + page_size - 1) / page_size * page_size;
+  }
+
+private:
+  /*
+   * Transparent huge pages only back the huge-page-aligned ranges, so map a
+   * bit more and trim the head and the tail.
+   * The pages are pre-faulted after madvise, otherwise they would be faulted
+   * as normal pages.
+   * */
+  static void *map_aligned(const std::size_t &length, const bool &prefault) {
+    void *ptr = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+      return nullptr;
+    auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    auto aligned = (address + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (aligned != address)
+      munmap(ptr, aligned - address);
+    if (aligned + length != address + length + huge_page_size)
+      munmap(reinterpret_cast<void *>(aligned + length),
+             address + huge_page_size - aligned);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void *>(aligned), length, MADV_HUGEPAGE);
+#endif
+    if (prefault) {
+      const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+      for (std::size_t offset = 0; offset < length; offset += page_size)
+        reinterpret_cast<volatile char *>(aligned)[offset] = 0;
+    }
+    return reinterpret_cast<void *>(aligned);
+  }
+
+  unsigned flags;
+};
+} // namespace memory_pool
+
+#endif // BLOCK_PROVIDER_H
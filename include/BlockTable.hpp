@@ -0,0 +1,110 @@
+/*
+ * @author: Pei Mu
+ * @description: Out-of-line table of the memory blocks
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef BLOCK_TABLE_H
+#define BLOCK_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace memory_pool {
+/*
+ * A block of memory, described out of the block itself.
+ * The block begins offset bytes after the memory from the provider, when the
+ * block is aligned more than the provider does.
+ * */
+struct BlockDescriptor {
+  char *begin;
+  std::size_t size;
+  std::size_t offset = 0;
+
+  char *end() const { return begin + size; }
+};
+
+/*
+ * The blocks of a pool in a dense table, instead of a footer at the tail of
+ * each block. A block is exactly the size given to the provider, so it can
+ * be a whole page or hugepage, and a scan of the blocks reads a few cache
+ * lines instead of a cold one per block.
+ * The blocks are kept in allocation order, and in address order to find the
+ * block of an address with a binary search.
+ * */
+class BlockTable {
+public:
+  typedef std::vector<BlockDescriptor>::const_iterator const_iterator;
+
+  void add(void *const block, const std::size_t &size,
+           const std::size_t &offset = 0) {
+    const BlockDescriptor descriptor{static_cast<char *>(block), size, offset};
+    // reserve both first, so a failure leaves the table unchanged
+    blocks.reserve(blocks.size() + 1);
+    by_address.reserve(by_address.size() + 1);
+    blocks.push_back(descriptor);
+    by_address.insert(upper_bound(descriptor.begin), descriptor);
+  }
+
+  void remove(void *const block) {
+    auto sorted = upper_bound(static_cast<char *>(block));
+    if (sorted == by_address.begin() || (--sorted)->begin != block)
+      return;
+    by_address.erase(sorted);
+    blocks.erase(std::find_if(
+        blocks.begin(), blocks.end(),
+        [block](const BlockDescriptor &lhs) { return lhs.begin == block; }));
+  }
+
+  void clear() {
+    blocks.clear();
+    by_address.clear();
+  }
+
+  /*
+   * The block holding address, or nullptr if there is no one.
+   * */
+  const BlockDescriptor *find(const void *const address) const {
+    auto iter = upper_bound(static_cast<const char *>(address));
+    if (iter == by_address.begin())
+      return nullptr;
+    --iter;
+    return std::less<>()(address, iter->end()) ? &*iter : nullptr;
+  }
+
+  bool empty() const { return blocks.empty(); }
+  std::size_t size() const { return blocks.size(); }
+
+  /*
+   * The blocks in allocation order, the last one is the newest.
+   * */
+  const BlockDescriptor &operator[](const std::size_t &i) const {
+    return blocks[i];
+  }
+  const BlockDescriptor &back() const { return blocks.back(); }
+  const_iterator begin() const { return blocks.begin(); }
+  const_iterator end() const { return blocks.end(); }
+
+  /*
+   * The blocks in address order.
+   * */
+  const std::vector<BlockDescriptor> &sorted() const { return by_address; }
+
+private:
+  std::vector<BlockDescriptor>::const_iterator
+  upper_bound(const char *const address) const {
+    return std::upper_bound(by_address.begin(), by_address.end(), address,
+                            [](const char *const ptr,
+                               const BlockDescriptor &rhs) {
+                              return std::less<>()(ptr, rhs.begin);
+                            });
+  }
+
+  std::vector<BlockDescriptor> blocks;
+  std::vector<BlockDescriptor> by_address;
+};
+} // namespace memory_pool
+
+#endif // BLOCK_TABLE_H
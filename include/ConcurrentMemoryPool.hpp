@@ -0,0 +1,298 @@
+/*
+ * @author: Pei Mu
+ * @description: Thread-safe memory pool with per-thread magazine caches
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef CONCURRENT_MEMORY_POOL_H
+#define CONCURRENT_MEMORY_POOL_H
+
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace memory_pool {
+
+/*
+ * A fixed size stack of free chunks.
+ * A magazine is only touched by the thread holding it, so it needs no lock.
+ * */
+class Magazine {
+public:
+  static constexpr std::size_t capacity = 64;
+
+  bool empty() const { return rounds == 0; }
+
+  bool full() const { return rounds == capacity; }
+
+  void push(void *const chunk) {
+    assert(!full());
+    chunks[rounds++] = chunk;
+  }
+
+  void *pop() {
+    assert(!empty());
+    return chunks[--rounds];
+  }
+
+  /*
+   * Fill the magazine from a RawMemoryPool in one go.
+   * */
+  template <typename source_type> void refill(source_type &source) {
+    rounds += source.malloc_chunks(chunks + rounds, capacity - rounds);
+  }
+
+private:
+  std::size_t rounds = 0;
+  void *chunks[capacity];
+};
+
+/*
+ * The concurrent mode of the memory pool.
+ * Ref: Bonwick and Adams, "Magazines and Vmem", USENIX 2001.
+ *
+ * Every thread keeps two magazines (loaded and previous) for each pool, and
+ * serves construct()/destroy() from them without any synchronization.
+ * Only when both magazines are empty (or full) the thread goes to the shared
+ * depot, and exchanges a whole magazine under the depot lock. A chunk can be
+ * destroyed by any thread: it just lands in that thread's magazine and goes
+ * back to the depot in a batch later.
+ *
+ * Objects that are still alive when the pool is released are not destructed.
+ * The blocks go back to block_provider at once, and the magazines of every
+ * thread are dropped with them, whether the threads are still running or not.
+ * No thread may use the pool while it is released.
+ * */
+template <typename element_type,
+          typename block_provider = MallocBlockProvider>
+class ConcurrentMemoryPool {
+public:
+  explicit ConcurrentMemoryPool(
+      const std::size_t &chunks_num_val = 32,
+      const std::size_t &max_chunks_val = 0,
+      const block_provider &provider_val = block_provider())
+      : id(next_pool_id()), depot(std::make_shared<Depot>(
+                                chunks_num_val, max_chunks_val, provider_val)) {
+  }
+
+  ConcurrentMemoryPool(const ConcurrentMemoryPool &) = delete;
+  ConcurrentMemoryPool &operator=(const ConcurrentMemoryPool &) = delete;
+
+  /*
+   * Take the magazines back from the caches of all threads, and release the
+   * blocks. A cache left behind is only a pointer to the empty depot, and
+   * is dropped when its thread exits or touches another pool.
+   * */
+  ~ConcurrentMemoryPool() {
+    std::lock_guard<std::mutex> guard(depot->lock);
+    depot->closed.store(true);
+    for (auto cache : depot->caches)
+      cache->drop_magazines();
+    depot->caches.clear();
+    for (auto magazine : depot->full_magazines)
+      delete magazine;
+    for (auto magazine : depot->empty_magazines)
+      delete magazine;
+    depot->full_magazines.clear();
+    depot->empty_magazines.clear();
+    depot->chunks.reset();
+  }
+
+  template <typename... Args> element_type *construct(Args &&...args) {
+    element_type *ret = static_cast<element_type *>(allocate());
+    if (ret == nullptr)
+      return ret;
+    try {
+      construct_element<element_type>(ret, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(ret);
+      throw;
+    }
+    return ret;
+  }
+
+  void destroy(element_type *const chunk) {
+    destroy_element(*chunk);
+    deallocate(chunk);
+  }
+
+private:
+  struct ThreadCache;
+
+  /*
+   * The shared part of the pool.
+   * It's kept alive by the pool and by every thread cache that refers to it,
+   * but the chunks are only owned by the pool.
+   * */
+  struct Depot {
+    Depot(const std::size_t &chunks_num_val, const std::size_t &max_chunks_val,
+          const block_provider &provider_val)
+        : chunks(std::make_unique<RawMemoryPool<element_type, block_provider>>(
+              chunks_num_val, max_chunks_val, false, provider_val)) {}
+
+    ~Depot() {
+      for (auto magazine : full_magazines)
+        delete magazine;
+      for (auto magazine : empty_magazines)
+        delete magazine;
+    }
+
+    std::mutex lock;
+    std::vector<Magazine *> full_magazines;
+    std::vector<Magazine *> empty_magazines;
+    // the caches of all threads holding magazines of this pool
+    std::vector<ThreadCache *> caches;
+    std::unique_ptr<RawMemoryPool<element_type, block_provider>> chunks;
+    std::atomic<bool> closed{false};
+  };
+
+  struct ThreadCache {
+    explicit ThreadCache(std::shared_ptr<Depot> depot_val)
+        : depot(std::move(depot_val)), loaded(new Magazine()),
+          previous(new Magazine()) {
+      std::lock_guard<std::mutex> guard(depot->lock);
+      depot->caches.push_back(this);
+    }
+
+    /*
+     * Give the magazines back to the depot when the thread exits.
+     * */
+    ~ThreadCache() {
+      std::lock_guard<std::mutex> guard(depot->lock);
+      // the pool has taken the magazines already
+      if (depot->closed.load())
+        return;
+      depot->caches.erase(
+          std::find(depot->caches.begin(), depot->caches.end(), this));
+      for (auto magazine : {loaded, previous}) {
+        if (magazine->empty())
+          depot->empty_magazines.push_back(magazine);
+        else
+          depot->full_magazines.push_back(magazine);
+      }
+    }
+
+    /*
+     * Called by the pool under the depot lock when it's released, the chunks
+     * in the magazines go with the blocks.
+     * */
+    void drop_magazines() {
+      delete loaded;
+      delete previous;
+      loaded = previous = nullptr;
+    }
+
+    std::shared_ptr<Depot> depot;
+    Magazine *loaded;
+    Magazine *previous;
+  };
+
+  /*
+   * All the caches of this thread, one for each live pool it has touched.
+   * */
+  struct ThreadCacheRegistry {
+    std::uint64_t last_id = 0;
+    ThreadCache *last_cache = nullptr;
+    std::vector<std::pair<std::uint64_t, std::unique_ptr<ThreadCache>>> caches;
+  };
+
+  static std::uint64_t next_pool_id() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+  }
+
+  static ThreadCacheRegistry &registry() {
+    thread_local ThreadCacheRegistry caches;
+    return caches;
+  }
+
+  ThreadCache &thread_cache() {
+    ThreadCacheRegistry &reg = registry();
+    if (reg.last_id == id)
+      return *reg.last_cache;
+
+    ThreadCache *cache = nullptr;
+    for (auto iter = reg.caches.begin(); iter != reg.caches.end();) {
+      if (iter->first == id) {
+        cache = iter->second.get();
+        ++iter;
+      } else if (iter->second->depot->closed.load()) {
+        // the pool has gone, drop the cache left behind
+        iter = reg.caches.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    if (cache == nullptr) {
+      reg.caches.emplace_back(id, std::make_unique<ThreadCache>(depot));
+      cache = reg.caches.back().second.get();
+    }
+    reg.last_id = id;
+    reg.last_cache = cache;
+    return *cache;
+  }
+
+  void *allocate() {
+    ThreadCache &cache = thread_cache();
+    if (!cache.loaded->empty())
+      return cache.loaded->pop();
+    if (!cache.previous->empty()) {
+      std::swap(cache.loaded, cache.previous);
+      return cache.loaded->pop();
+    }
+
+    std::lock_guard<std::mutex> guard(depot->lock);
+    if (!depot->full_magazines.empty()) {
+      depot->empty_magazines.push_back(cache.previous);
+      cache.previous = cache.loaded;
+      cache.loaded = depot->full_magazines.back();
+      depot->full_magazines.pop_back();
+      return cache.loaded->pop();
+    }
+
+    // the depot is dry, carve a batch of fresh chunks
+    cache.loaded->refill(*depot->chunks);
+    if (cache.loaded->empty())
+      return nullptr;
+    return cache.loaded->pop();
+  }
+
+  void deallocate(void *const chunk) {
+    ThreadCache &cache = thread_cache();
+    if (!cache.loaded->full()) {
+      cache.loaded->push(chunk);
+      return;
+    }
+    if (cache.previous->empty()) {
+      std::swap(cache.loaded, cache.previous);
+      cache.loaded->push(chunk);
+      return;
+    }
+
+    Magazine *magazine = nullptr;
+    {
+      std::lock_guard<std::mutex> guard(depot->lock);
+      depot->full_magazines.push_back(cache.previous);
+      if (!depot->empty_magazines.empty()) {
+        magazine = depot->empty_magazines.back();
+        depot->empty_magazines.pop_back();
+      }
+    }
+    if (magazine == nullptr)
+      magazine = new Magazine();
+    cache.previous = cache.loaded;
+    cache.loaded = magazine;
+    cache.loaded->push(chunk);
+  }
+
+  const std::uint64_t id;
+  std::shared_ptr<Depot> depot;
+};
+} // namespace memory_pool
+
+#endif // CONCURRENT_MEMORY_POOL_H
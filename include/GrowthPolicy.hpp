@@ -0,0 +1,85 @@
+/*
+ * @author: Pei Mu
+ * @description: Growth policies of the memory pool blocks
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace memory_pool {
+/*
+ * A growth policy gives the chunk number of the next block:
+ *  next_chunk_num(chunk_num): a block of chunk_num chunks is just allocated.
+ * The result is capped by max_chunk_num of the pool, and is at least 1.
+ * */
+
+/*
+ * Multiply the chunk number by numerator / denominator, at least by one
+ * chunk. The default doubles it.
+ * */
+template <std::size_t numerator = 2, std::size_t denominator = 1>
+struct GeometricGrowth {
+  static_assert(numerator > denominator && denominator > 0,
+                "the growth factor must be greater than 1");
+
+  std::size_t next_chunk_num(const std::size_t &chunk_num) {
+    return std::max(chunk_num + 1, chunk_num / denominator * numerator +
+                                       chunk_num % denominator * numerator /
+                                           denominator);
+  }
+};
+
+/*
+ * Add step chunks to every block.
+ * */
+template <std::size_t step> struct LinearGrowth {
+  static_assert(step > 0, "the growth step must be positive");
+
+  std::size_t next_chunk_num(const std::size_t &chunk_num) {
+    return chunk_num + step;
+  }
+};
+
+/*
+ * Size the next block for the chunks taken in the next horizon_us
+ * microseconds, at the rate the last block was used up: a burst gets blocks
+ * up to max_factor times bigger at once, and a slow steady growth gets
+ * smaller blocks. The chunk number changes by max_factor at most per block.
+ * The time comes from clock::now(), which a test can replace.
+ * */
+template <std::size_t horizon_us = 10000, std::size_t max_factor = 4,
+          typename clock = std::chrono::steady_clock>
+class AdaptiveGrowth {
+  static_assert(max_factor > 1, "the growth factor must be greater than 1");
+
+public:
+  std::size_t next_chunk_num(const std::size_t &chunk_num) {
+    const auto now = clock::now();
+    std::size_t next = chunk_num * 2;
+    if (last_chunk_num != 0) {
+      const double elapsed_us = std::max(
+          std::chrono::duration<double, std::micro>(now - last_resize).count(),
+          1.0);
+      const double wanted = static_cast<double>(last_chunk_num) *
+                            static_cast<double>(horizon_us) / elapsed_us;
+      next = static_cast<std::size_t>(std::clamp(
+          wanted, static_cast<double>(chunk_num / max_factor),
+          static_cast<double>(chunk_num * max_factor)));
+    }
+    last_resize = now;
+    last_chunk_num = chunk_num;
+    return std::max<std::size_t>(next, 1);
+  }
+
+private:
+  typename clock::time_point last_resize;
+  std::size_t last_chunk_num = 0;
+};
+} // namespace memory_pool
+
+#endif // GROWTH_POLICY_H
@@ -0,0 +1,278 @@
+/*
+ * @author: Pei Mu
+ * @description: Memory pool handing out 32-bit handles instead of pointers
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef HANDLE_MEMORY_POOL_H
+#define HANDLE_MEMORY_POOL_H
+
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace memory_pool {
+/*
+ * The blocks of a pool by number, with a generation for each chunk.
+ * A released block leaves its number free for the next block, whose
+ * generations continue after the last one of the number, so the handles of
+ * the released block stay stale.
+ * */
+class HandleBlockTable {
+public:
+  HandleBlockTable(const std::size_t &partition_size_val,
+                   const std::size_t &max_blocks_val,
+                   const std::size_t &max_chunks_val)
+      : partition_size(partition_size_val), max_blocks(max_blocks_val),
+        max_chunks(max_chunks_val) {}
+
+  struct Block {
+    char *begin = nullptr;
+    std::size_t chunk_num = 0;
+    std::vector<std::uint8_t> generations;
+    std::uint8_t next_generation = 1;
+  };
+
+  /*
+   * Return false if there is no free number, or if the block has too many
+   * chunks for a handle.
+   * */
+  bool add(void *const block, const std::size_t &size) {
+    const std::size_t chunk_num = size / partition_size;
+    if (chunk_num > max_chunks)
+      return false;
+    auto free_block = std::find_if(
+        blocks.begin(), blocks.end(),
+        [](const Block &block) { return block.begin == nullptr; });
+    if (free_block == blocks.end()) {
+      if (blocks.size() == max_blocks)
+        return false;
+      free_block = blocks.emplace(blocks.end());
+    }
+    free_block->begin = static_cast<char *>(block);
+    free_block->chunk_num = chunk_num;
+    free_block->generations.assign(chunk_num, free_block->next_generation);
+
+    const auto number =
+        static_cast<std::size_t>(free_block - blocks.begin());
+    by_address.insert(std::upper_bound(by_address.begin(), by_address.end(),
+                                       std::make_pair(free_block->begin,
+                                                      number)),
+                      std::make_pair(free_block->begin, number));
+    return true;
+  }
+
+  void remove(void *const block) {
+    auto iter = std::lower_bound(
+        by_address.begin(), by_address.end(), static_cast<char *>(block),
+        [](const std::pair<char *, std::size_t> &lhs, char *const ptr) {
+          return std::less<>()(lhs.first, ptr);
+        });
+    if (iter == by_address.end() || iter->first != block)
+      return;
+    Block &released = blocks[iter->second];
+    // the next block starts after the generation furthest from its start
+    std::uint8_t last = released.next_generation;
+    for (auto generation : released.generations) {
+      if (static_cast<std::uint8_t>(generation - released.next_generation) >
+          static_cast<std::uint8_t>(last - released.next_generation))
+        last = generation;
+    }
+    released.next_generation = next(last);
+    released.begin = nullptr;
+    released.chunk_num = 0;
+    released.generations.clear();
+    by_address.erase(iter);
+  }
+
+  /*
+   * The number of the block holding chunk, it must be in a block.
+   * */
+  std::size_t find(const void *const chunk) const {
+    auto iter = std::upper_bound(
+        by_address.begin(), by_address.end(),
+        static_cast<const char *>(chunk),
+        [](const char *const ptr, const std::pair<char *, std::size_t> &rhs) {
+          return std::less<>()(ptr, rhs.first);
+        });
+    assert(iter != by_address.begin() && "the chunk is not from this pool");
+    return (--iter)->second;
+  }
+
+  /*
+   * The next generation after generation, 0 is never used.
+   * */
+  static std::uint8_t next(const std::uint8_t &generation) {
+    const std::uint8_t ret = generation + 1;
+    return ret == 0 ? 1 : ret;
+  }
+
+  const std::size_t partition_size;
+  const std::size_t max_blocks;
+  const std::size_t max_chunks;
+  std::vector<Block> blocks;
+
+private:
+  std::vector<std::pair<char *, std::size_t>> by_address;
+};
+
+/*
+ * Keep the blocks of block_provider in a HandleBlockTable.
+ * */
+template <typename block_provider> class HandleBlockProvider {
+public:
+  static constexpr std::size_t block_alignment =
+      block_alignment_of<block_provider>::value;
+
+  HandleBlockProvider(HandleBlockTable *table_val,
+                      const block_provider &provider_val)
+      : table(table_val), provider(provider_val) {}
+
+  void *allocate(const std::size_t &size) {
+    void *const block = provider.allocate(size);
+    if (block == nullptr)
+      return nullptr;
+    if (!table->add(block, size)) {
+      provider.deallocate(block, size);
+      return nullptr;
+    }
+    return block;
+  }
+
+  void deallocate(void *const block, const std::size_t &size) {
+    table->remove(block);
+    provider.deallocate(block, size);
+  }
+
+private:
+  HandleBlockTable *table;
+  block_provider provider;
+};
+
+/*
+ * A memory pool whose objects are referred to by 32-bit handles instead of
+ * 8-byte pointers, which halves the references of pointer-heavy structures.
+ * A handle holds, from the high bits, an 8-bit generation, the block number
+ * and the chunk index in the block, and is resolved through the block table.
+ * The handles do not depend on the addresses of the blocks.
+ *
+ * Every destroy() moves the generation of the chunk on, so a stale handle
+ * resolves to nullptr, unless the chunk is reused 255 times meanwhile.
+ * With block_bits, at most 2^block_bits blocks of 2^(24 - block_bits)
+ * chunks are used, a full pool returns null_handle. The handle 0 is never
+ * handed out.
+ * */
+template <typename element_type, std::size_t block_bits = 8,
+          typename block_provider = MallocBlockProvider>
+class HandleMemoryPool {
+  static_assert(block_bits > 0 && block_bits < 24,
+                "the chunk index needs at least one bit");
+  // the table indexes the chunks from the begin of the provided blocks
+  static_assert(alignof(element_type) <=
+                    block_alignment_of<block_provider>::value,
+                "the provider must align the blocks for the element");
+
+public:
+  typedef std::uint32_t handle_type;
+  static constexpr handle_type null_handle = 0;
+  static constexpr std::size_t generation_bits = 8;
+  static constexpr std::size_t chunk_bits = 32 - generation_bits - block_bits;
+  static constexpr std::size_t max_blocks = std::size_t(1) << block_bits;
+  static constexpr std::size_t max_block_chunks = std::size_t(1)
+                                                  << chunk_bits;
+
+  explicit HandleMemoryPool(const std::size_t &chunks_num_val = 32,
+                            const std::size_t &max_chunks_val = 0,
+                            const block_provider &provider_val =
+                                block_provider())
+      : table(partition_size(), max_blocks, max_block_chunks),
+        pool(std::min(chunks_num_val, max_block_chunks),
+             max_chunks(max_chunks_val), false,
+             HandleBlockProvider<block_provider>(&table, provider_val)) {}
+
+  template <typename... Args> handle_type construct(Args &&...args) {
+    element_type *const chunk = pool.construct(std::forward<Args>(args)...);
+    if (chunk == nullptr)
+      return null_handle;
+    const std::size_t number = table.find(chunk);
+    const auto &block = table.blocks[number];
+    const auto index = static_cast<std::size_t>(
+        (reinterpret_cast<char *>(chunk) - block.begin) / partition_size());
+    return static_cast<handle_type>(
+        (std::size_t(block.generations[index]) << (block_bits + chunk_bits)) |
+        (number << chunk_bits) | index);
+  }
+
+  /*
+   * Return false if the handle is stale.
+   * */
+  bool destroy(const handle_type &handle) {
+    element_type *const chunk = resolve(handle);
+    if (chunk == nullptr)
+      return false;
+    auto &generation =
+        table.blocks[block_of(handle)].generations[index_of(handle)];
+    generation = HandleBlockTable::next(generation);
+    pool.destroy(chunk);
+    return true;
+  }
+
+  /*
+   * The object of a handle, or nullptr if the handle is stale.
+   * */
+  element_type *resolve(const handle_type &handle) const {
+    const std::size_t number = block_of(handle);
+    if (number >= table.blocks.size())
+      return nullptr;
+    const auto &block = table.blocks[number];
+    const std::size_t index = index_of(handle);
+    if (index >= block.chunk_num ||
+        block.generations[index] != handle >> (block_bits + chunk_bits))
+      return nullptr;
+    return reinterpret_cast<element_type *>(block.begin +
+                                            index * partition_size());
+  }
+
+  /*
+   * Give the fully free blocks back, their numbers are reused.
+   * */
+  bool release_memory() { return pool.release_memory(); }
+
+private:
+  static std::size_t block_of(const handle_type &handle) {
+    return (handle >> chunk_bits) & (max_blocks - 1);
+  }
+
+  static std::size_t index_of(const handle_type &handle) {
+    return handle & (max_block_chunks - 1);
+  }
+
+  typedef MemoryPool<element_type, HandleBlockProvider<block_provider>>
+      pool_type;
+
+  /*
+   * The chunk size of the pool, the handles index the chunks with it.
+   * */
+  static constexpr std::size_t partition_size() {
+    return pool_type::alloc_size();
+  }
+
+  /*
+   * Cap the blocks to max_block_chunks, max_chunks of MemoryPool is counted
+   * in element_type.
+   * */
+  static std::size_t max_chunks(const std::size_t &max_chunks_val) {
+    const std::size_t cap =
+        max_block_chunks * partition_size() / sizeof(element_type);
+    return max_chunks_val == 0 ? cap : std::min(max_chunks_val, cap);
+  }
+
+  // the table outlives the pool, which removes its blocks
+  HandleBlockTable table;
+  pool_type pool;
+};
+} // namespace memory_pool
+
+#endif // HANDLE_MEMORY_POOL_H
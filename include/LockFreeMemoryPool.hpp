@@ -0,0 +1,89 @@
+/*
+ * @author: Pei Mu
+ * @description: Memory pool over the lock-free segregated storage
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef LOCK_FREE_MEMORY_POOL_H
+#define LOCK_FREE_MEMORY_POOL_H
+
+#include "AtomicSegregatedStorage.hpp"
+#include "MemoryPool.hpp"
+#include <mutex>
+#include <utility>
+
+namespace memory_pool {
+/*
+ * Many threads can construct() and destroy() at the same time without any
+ * mutex, as long as the free list has chunks.
+ * Only growing the pool takes a lock: a batch of fresh chunks is carved from
+ * a RawMemoryPool, linked together and pushed to the free list at once.
+ *
+ * Objects that are still alive when the pool is released are not destructed,
+ * the blocks are given back to the system as they are.
+ * */
+template <typename element_type>
+class LockFreeMemoryPool : protected AtomicSegregatedStorage {
+public:
+  explicit LockFreeMemoryPool(const std::size_t &chunks_num_val = 32,
+                              const std::size_t &max_chunks_val = 0)
+      : chunks(chunks_num_val, max_chunks_val) {}
+
+  LockFreeMemoryPool(const LockFreeMemoryPool &) = delete;
+  LockFreeMemoryPool &operator=(const LockFreeMemoryPool &) = delete;
+
+  template <typename... Args> element_type *construct(Args &&...args) {
+    element_type *ret = static_cast<element_type *>(memory_pool_malloc());
+    if (ret == nullptr)
+      return ret;
+    try {
+      construct_element<element_type>(ret, std::forward<Args>(args)...);
+    } catch (...) {
+      AtomicSegregatedStorage::memory_pool_free(ret);
+      throw;
+    }
+    return ret;
+  }
+
+  void destroy(element_type *const chunk) {
+    destroy_element(*chunk);
+    AtomicSegregatedStorage::memory_pool_free(chunk);
+  }
+
+  /*
+   * The number of chunks linked at once when the free list runs dry.
+   * */
+  static constexpr std::size_t batch_size = 64;
+
+private:
+  element_type *memory_pool_malloc() {
+    void *ret = AtomicSegregatedStorage::memory_pool_malloc();
+    if (ret != nullptr)
+      return static_cast<element_type *>(ret);
+    return malloc_need_resize();
+  }
+
+  element_type *malloc_need_resize() {
+    std::lock_guard<std::mutex> guard(resize_lock);
+    // another thread may have refilled the free list in the meantime
+    void *ret = AtomicSegregatedStorage::memory_pool_malloc();
+    if (ret != nullptr)
+      return static_cast<element_type *>(ret);
+
+    void *batch[batch_size];
+    std::size_t taken = chunks.malloc_chunks(batch, batch_size);
+    if (taken == 0)
+      return nullptr;
+    for (std::size_t i = 1; i + 1 < taken; i++)
+      store_next(batch[i], batch[i + 1]);
+    if (taken > 1)
+      memory_pool_free_chain(batch[1], batch[taken - 1]);
+    return static_cast<element_type *>(batch[0]);
+  }
+
+  std::mutex resize_lock;
+  RawMemoryPool<element_type> chunks;
+};
+} // namespace memory_pool
+
+#endif // LOCK_FREE_MEMORY_POOL_H
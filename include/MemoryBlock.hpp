@@ -36,9 +36,16 @@ public:
   std::size_t total_size() const { return size; }
 
   std::size_t element_size() const {
-    return static_cast<std::size_t>(
-        size - sizeof(std::size_t) -
-        std::lcm(sizeof(std::size_t), sizeof(void *)));
+    return static_cast<std::size_t>(size - footer_size());
+  }
+
+  /*
+   * The bytes taken by next_ptr and next_size at the tail of each block.
+   * The chunks must stop right here, so that end() is reached by stepping
+   * over the chunks.
+   * */
+  static constexpr std::size_t footer_size() {
+    return std::lcm(sizeof(std::size_t), sizeof(void *)) + sizeof(std::size_t);
   }
 
   std::size_t &next_size() {
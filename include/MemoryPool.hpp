@@ -7,14 +7,56 @@
 #ifndef MEMORY_POOL_H
 #define MEMORY_POOL_H
 
-#include "MemoryBlock.hpp"
+#include "BlockProvider.hpp"
+#include "BlockTable.hpp"
+#include "GrowthPolicy.hpp"
+#include "PoolStats.hpp"
 #include "SimpleSegregatedStorage.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace memory_pool {
 
+/*
+ * When to give the fully free blocks back to the system automatically.
+ * Every check_interval frees, if at least free_fraction of all chunks are
+ * free, the pool looks for the fully free blocks, and releases those that
+ * have been found fully free for idle_time.
+ * A check_interval of 0 disables the automatic trim.
+ * */
+struct TrimPolicy {
+  std::size_t check_interval = 0;
+  double free_fraction = 0.5;
+  std::chrono::steady_clock::duration idle_time = std::chrono::seconds(1);
+};
+
+/*
+ * Define MEMORY_POOL_CHECK_OWNER to make every destroy and free check that
+ * the chunk is from the pool, and throw std::invalid_argument before
+ * anything is changed if it's not. Each check is a binary search over the
+ * blocks.
+ * The macro changes the definition of every pool, so it must be defined for
+ * the whole program (e.g. with add_compile_definitions) or for none of it.
+ * Mixing both in one program breaks the one definition rule, and the linker
+ * silently keeps either version of each pool.
+ * */
+#ifdef MEMORY_POOL_CHECK_OWNER
+inline constexpr bool check_owner = true;
+#else
+inline constexpr bool check_owner = false;
+#endif
+
+template <typename element_type, typename... Args>
+element_type *construct_element(void *const chunk, Args &&...args);
 template <typename element_type> void destroy_element(element_type &ele);
 template <typename element_type, std::size_t N>
 void destroy_element(element_type (&ele)[N]);
@@ -22,15 +64,44 @@ void destroy_element(element_type (&ele)[N]);
 /*
  * The user interface of Memory Pool.
  * Use template to be suitable for all kinds of data types.
+ *
+ * With lazy_segregation_val, a new block is not split into the free list at
+ * once, but served from a bump pointer (see add_block_lazy).
+ * The blocks come from block_provider (see BlockProvider.hpp), the events
+ * are counted by stats_policy (see PoolStats.hpp), and the chunk number of
+ * each new block is given by growth_policy (see GrowthPolicy.hpp).
+ *
+ * Every chunk is aligned to alignment, and its size is rounded up to it, e.g.
+ * 64 pads the objects to a cache line, so the objects used by different
+ * threads don't share a line. A block is over-allocated by the difference
+ * when the provider aligns it less (see block_alignment_of).
+ *
+ * MEMORY_POOL_CHECK_OWNER must be defined the same way in every translation
+ * unit that includes this header (see check_owner).
  * */
-template <typename element_type>
-class MemoryPool : protected SimpleSegregatedStorage {
+template <typename element_type,
+          typename block_provider = MallocBlockProvider,
+          typename stats_policy = NoStats,
+          typename growth_policy = GeometricGrowth<>,
+          std::size_t alignment = alignof(element_type)>
+class MemoryPool : protected SimpleSegregatedStorage,
+                   protected StatsHolder<stats_policy> {
+  static_assert((alignment & (alignment - 1)) == 0 &&
+                    alignment >= alignof(element_type),
+                "the alignment must be a power of two, and no less than the "
+                "alignment of the element");
+
 public:
   explicit MemoryPool(const std::size_t &chunks_num_val = 32,
-                      const std::size_t &max_chunks_val = 0)
-      : memory_blocks(nullptr, 0), requested_size(sizeof(element_type)) {
+                      const std::size_t &max_chunks_val = 0,
+                      const bool &lazy_segregation_val = false,
+                      const block_provider &provider_val = block_provider())
+      : requested_size(sizeof(element_type)),
+        lazy_segregation(lazy_segregation_val), provider(provider_val) {
     set_chunk_num(chunks_num_val);
     set_max_size(max_chunks_val);
+    start_chunk_num = chunk_num;
+    this->statistics().init(alloc_size());
   }
 
   /*
@@ -38,34 +109,141 @@ public:
    * */
   ~MemoryPool() { purge_memory(); }
 
-  element_type *construct() {
+  /*
+   * Construct an object in place with the given arguments.
+   * The arguments are forwarded to the constructor, so types without a
+   * default constructor are constructed exactly once as well.
+   * */
+  template <typename... Args> element_type *construct(Args &&...args) {
     element_type *ret = memory_pool_malloc();
-    auto next_of_ret = next_of(ret);
+    if (ret == nullptr)
+      return ret;
     try {
-      /*
-       * Maybe the easiest way to check if it has a default construction.
-       * */
-      if constexpr (std::is_default_constructible<element_type>::value)
-        new (ret) element_type();
-      next_of(ret) = next_of_ret;
-      if (ret == nullptr)
-        return ret;
+      construct_element<element_type>(ret, std::forward<Args>(args)...);
     } catch (...) {
-      free(ret);
+      memory_pool_free(ret);
       throw;
     }
+    this->statistics().on_construct(ret);
     return ret;
   }
 
+  /*
+   * Destruct an object and give its chunk back to the pool.
+   * */
   void destroy(element_type *const chunk) {
-    /*
-     * The example gives the virtual destructor...
-     * */
+    check_free(chunk);
+    this->statistics().on_destroy(chunk);
     destroy_element(*chunk);
 
     memory_pool_free(chunk);
   }
 
+  /*
+   * Construct n objects at once with the same arguments, and write their
+   * addresses to chunks.
+   * Return the number of constructed objects, which is less than n only if
+   * the system runs out of memory.
+   * */
+  template <typename... Args>
+  std::size_t construct_n(element_type **chunks, const std::size_t &n,
+                          const Args &...args);
+
+  /*
+   * Destroy n objects at once.
+   * The chunks are linked to each other first, and the whole chain is spliced
+   * back to the free list with a single write.
+   * */
+  void destroy_n(element_type *const *chunks, const std::size_t &n);
+
+  /*
+   * Allocate n contiguous chunks, e.g. for a small array of element_type.
+   * Nothing is constructed in the chunks.
+   * The free list is kept in address order by the ordered calls
+   * (allocate_contiguous, free_contiguous and ordered_destroy), so mixing
+   * them with destroy() only makes adjacent chunks harder to find.
+   * The chunks must be given back before the pool is purged, otherwise they
+   * are taken as live objects to destroy.
+   * */
+  element_type *allocate_contiguous(const std::size_t &n);
+
+  /*
+   * Give back n contiguous chunks from allocate_contiguous.
+   * */
+  void free_contiguous(element_type *const chunks, const std::size_t &n) {
+    check_free(chunks);
+    this->ordered_free_n(chunks, n, alloc_size());
+    count_free(n);
+  }
+
+  /*
+   * Destroy an object and keep the free list in address order.
+   * */
+  void ordered_destroy(element_type *const chunk) {
+    check_free(chunk);
+    this->statistics().on_destroy(chunk);
+    destroy_element(*chunk);
+    this->ordered_free(chunk);
+    count_free(1);
+  }
+
+  /*
+   * Give the blocks whose chunks are all free back to the system, and unlink
+   * their chunks from the free list. The free list is left in address order.
+   * Return true if any block is released.
+   * */
+  bool release_memory() {
+    return release_blocks(std::chrono::steady_clock::now(),
+                          std::chrono::steady_clock::duration::zero());
+  }
+
+  /*
+   * Make sure that n chunks can be taken without allocating a block, e.g.
+   * before a known burst. The missing chunks are allocated in one block,
+   * which does not change the chunk number of the next blocks.
+   * Return false if the block cannot be allocated.
+   * */
+  bool reserve(const std::size_t &n);
+
+  /*
+   * Check if chunk is a chunk of this pool, in O(log blocks), e.g. to
+   * route a free between pools. A pointer into the middle of a chunk is not.
+   * */
+  bool owns(const void *const chunk) const {
+    const BlockDescriptor *const block = memory_blocks.find(chunk);
+    return block != nullptr &&
+           static_cast<std::size_t>(static_cast<const char *>(chunk) -
+                                    block->begin) %
+                   alloc_size() ==
+               0;
+  }
+
+  const stats_policy &get_stats() const { return this->statistics(); }
+
+  /*
+   * Get the size of size that will be allocated.
+   * For alignment purpose, rounding up to the minimum required alignment.
+   * The chunks of a block start at its begin, one every alloc_size() bytes.
+   * */
+  static constexpr std::size_t alloc_size() {
+    std::size_t s = std::max(sizeof(element_type), min_alloc_size);
+    std::size_t rem = s % min_align;
+    if (rem)
+      s += min_align - rem;
+    assert(s >= min_alloc_size);
+    assert(s % min_align == 0);
+    return s;
+  }
+
+  /*
+   * Enable or disable the automatic trim (see TrimPolicy).
+   * */
+  void set_trim_policy(const TrimPolicy &policy) {
+    trim_policy = policy;
+    trim_countdown = policy.check_interval;
+    idle_blocks.clear();
+  }
+
 protected:
   void set_chunk_num(const std::size_t &next_size_val) {
     chunk_num = std::min(next_size_val, max_chunks());
@@ -83,22 +261,39 @@ protected:
   /*
    * The key instant to store the memory pool.
    * */
-  MemoryBlock memory_blocks;
+  BlockTable memory_blocks;
   const std::size_t requested_size;
   std::size_t chunk_num{};
   std::size_t max_chunk_num{};
+  const bool lazy_segregation;
+  std::size_t start_chunk_num{};
+  block_provider provider;
+  growth_policy growth;
+
+  /*
+   * The number of chunks handed out, for the free fraction of TrimPolicy.
+   * */
+  std::size_t live_chunks = 0;
 
-private:
   /*
    * The interface of malloc.
    * If it's the first time to malloc a trunk,
    *  we need to construct the memory pool first.
    * */
   element_type *memory_pool_malloc() {
+    live_chunks++;
+    this->statistics().on_malloc(1);
     if (this->free_memory != nullptr)
       return static_cast<element_type *>(
           SimpleSegregatedStorage::memory_pool_malloc());
-    return malloc_need_resize();
+    if (this->carvable())
+      return static_cast<element_type *>(this->carve());
+    element_type *const ret = malloc_need_resize();
+    if (ret == nullptr) {
+      live_chunks--;
+      this->statistics().on_free(1);
+    }
+    return ret;
   }
 
   /*
@@ -106,78 +301,475 @@ private:
    * */
   void memory_pool_free(element_type *const chunk) {
     SimpleSegregatedStorage::memory_pool_free(chunk);
+    count_free(1);
   }
 
   /*
-   * Get the size of size that will be allocated.
-   * For alignment purpose, rounding up to the minimum required alignment.
+   * Reject a chunk from another pool (see check_owner).
    * */
-  std::size_t alloc_size() const {
-    std::size_t s = std::max(requested_size, min_alloc_size);
-    std::size_t rem = s % min_align;
-    if (rem)
-      s += min_align - rem;
-    assert(s >= min_alloc_size);
-    assert(s % min_align == 0);
-    return s;
+  void check_free(const void *const chunk) const {
+    if constexpr (check_owner) {
+      if (!owns(chunk))
+        throw std::invalid_argument("the chunk is not from this pool");
+    }
+  }
+
+  /*
+   * Count n freed chunks, and trim the pool every check_interval frees.
+   * */
+  void count_free(const std::size_t &n) {
+    live_chunks -= n;
+    this->statistics().on_free(n);
+    if (trim_countdown == 0)
+      return;
+    if (trim_countdown > n)
+      trim_countdown -= n;
+    else
+      auto_trim();
   }
 
+  /*
+   * Take n chunks as whole chains, from the free list, the bump pointer and
+   * new blocks, without constructing anything.
+   * Return the number of chunks taken.
+   * */
+  std::size_t memory_pool_malloc_n(element_type **chunks, const std::size_t &n);
+
+private:
   std::size_t max_chunks() const {
-    std::size_t block_size =
-        std::lcm(sizeof(element_type), sizeof(void *)) + sizeof(element_type);
-    return (std::numeric_limits<std::size_t>::max() - block_size) /
-           alloc_size();
+    return std::numeric_limits<std::size_t>::max() / alloc_size();
+  }
+
+  /*
+   * The number of chunks in all blocks.
+   * */
+  std::size_t total_chunks() const {
+    std::size_t bytes = 0;
+    for (const auto &block : memory_blocks)
+      bytes += block.size;
+    return bytes / alloc_size();
+  }
+
+  /*
+   * Allocate a block of num_chunks chunks and add it to the table.
+   * Return nullptr if either fails.
+   * */
+  char *allocate_block(const std::size_t &num_chunks) {
+    if (num_chunks >
+        (std::numeric_limits<std::size_t>::max() - block_padding) /
+            alloc_size())
+      return nullptr;
+    const std::size_t block_size = num_chunks * alloc_size();
+    auto *ptr =
+        static_cast<char *>(provider.allocate(block_size + block_padding));
+    if (ptr == nullptr)
+      return nullptr;
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(ptr) % alignment;
+    char *const begin = misalignment ? ptr + alignment - misalignment : ptr;
+    try {
+      memory_blocks.add(begin, block_size,
+                        static_cast<std::size_t>(begin - ptr));
+    } catch (...) {
+      provider.deallocate(ptr, block_size + block_padding);
+      return nullptr;
+    }
+    this->statistics().on_resize(block_size, num_chunks);
+    return begin;
+  }
+
+  /*
+   * Give a block of the table back to the provider.
+   * */
+  void deallocate_block(const BlockDescriptor &block) {
+    provider.deallocate(block.begin - block.offset,
+                        block.size + block_padding);
   }
 
   element_type *malloc_need_resize();
 
-  const std::size_t min_alloc_size =
+  element_type *ordered_malloc_need_resize(const std::size_t &n);
+
+  /*
+   * Release the fully free blocks which have been found fully free for
+   * idle_time, and remember the others with the time they are first found.
+   * */
+  bool release_blocks(const std::chrono::steady_clock::time_point &now,
+                      const std::chrono::steady_clock::duration &idle_time);
+
+  void auto_trim();
+
+  /*
+   * The free chunks of a block are marked in the bits from first_bit, one bit
+   * per chunk, in the bitmap shared by all blocks.
+   * */
+  struct BlockBits {
+    char *begin;
+    char *end;
+    std::size_t first_bit;
+    std::size_t free_num;
+  };
+
+  /*
+   * Mark the chunks of the free list in the bitmap with a single pass, so the
+   * blocks can be swept linearly afterwards, whatever the order of the free
+   * list is. The blocks are sorted by address, and the chunks behind the bump
+   * pointer are not marked.
+   * */
+  void mark_free_chunks(std::vector<BlockBits> &blocks,
+                        std::vector<std::uint64_t> &bits);
+
+  static bool test_bit(const std::vector<std::uint64_t> &bits,
+                       const std::size_t &bit) {
+    return (bits[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  /*
+   * Grow the chunk number of the next block with growth_policy, capped by
+   * max_chunk_num. A policy can always make the blocks smaller.
+   * */
+  void grow_chunk_num(const std::size_t &partition_size) {
+    const std::size_t next =
+        std::max<std::size_t>(growth.next_chunk_num(chunk_num), 1);
+    if (!max_chunk_num || next < chunk_num)
+      set_chunk_num(next);
+    else if (chunk_num * partition_size / requested_size < max_chunk_num)
+      set_chunk_num(std::min(
+          next, std::max<std::size_t>(
+                    max_chunk_num * requested_size / partition_size, 1)));
+  }
+
+  static constexpr std::size_t min_alloc_size =
       std::lcm(sizeof(void *), sizeof(element_type));
-  const std::size_t min_align = std::lcm(
-      std::alignment_of<void *>::value, std::alignment_of<element_type>::value);
+  static constexpr std::size_t min_align =
+      std::lcm(std::alignment_of<void *>::value, alignment);
+  // the bytes added to a block to align its begin
+  static constexpr std::size_t block_padding =
+      alignment > block_alignment_of<block_provider>::value
+          ? alignment - block_alignment_of<block_provider>::value
+          : 0;
+
+  TrimPolicy trim_policy;
+  std::size_t trim_countdown = 0;
+  std::vector<std::pair<void *, std::chrono::steady_clock::time_point>>
+      idle_blocks;
 };
 
-template <typename element_type>
-element_type *MemoryPool<element_type>::malloc_need_resize() {
-  std::size_t partition_size = alloc_size();
-  auto block_size = static_cast<std::size_t>(
-      chunk_num * partition_size +
-      std::lcm(sizeof(element_type), sizeof(void *)) + sizeof(element_type));
-  char *ptr = (char *)malloc(block_size);
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+element_type *
+MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+           alignment>::malloc_need_resize() {
+  const std::size_t partition_size = alloc_size();
+  char *ptr = allocate_block(chunk_num);
   if (ptr == nullptr) {
     if (chunk_num > 4) {
       chunk_num >>= 1;
-      partition_size = alloc_size();
-      block_size = static_cast<std::size_t>(
-          chunk_num * partition_size +
-          std::lcm(sizeof(element_type), sizeof(void *)) +
-          sizeof(element_type));
-      ptr = (char *)malloc(block_size);
+      ptr = allocate_block(chunk_num);
     }
     if (ptr == nullptr)
       return nullptr;
   }
+  const std::size_t block_size = chunk_num * partition_size;
+  grow_chunk_num(partition_size);
 
-  MemoryBlock node(ptr, block_size);
+  if (lazy_segregation) {
+    this->add_block_lazy(ptr, block_size, partition_size);
+    return static_cast<element_type *>(this->carve());
+  }
 
-  if (!max_chunk_num)
-    set_chunk_num(chunk_num << 1);
-  else if (chunk_num * partition_size / requested_size < max_chunk_num)
-    set_chunk_num(std::min(chunk_num << 1,
-                           max_chunk_num * requested_size / partition_size));
+  this->add_block(ptr, block_size, partition_size);
+  return static_cast<element_type *>(
+      SimpleSegregatedStorage::memory_pool_malloc());
+}
 
-  this->add_block(node.begin(), node.element_size(), partition_size);
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+element_type *
+MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+           alignment>::ordered_malloc_need_resize(
+    const std::size_t &n) {
+  const std::size_t partition_size = alloc_size();
+  const std::size_t num_chunks = std::max(chunk_num, n);
+  char *ptr = allocate_block(num_chunks);
+  if (ptr == nullptr)
+    return nullptr;
+  grow_chunk_num(partition_size);
+
+  // the first n chunks are taken, and the rest goes to the free list in order
+  if (num_chunks > n)
+    this->add_ordered_block(ptr + n * partition_size,
+                            (num_chunks - n) * partition_size,
+                            partition_size);
+  return reinterpret_cast<element_type *>(ptr);
+}
 
-  node.next(memory_blocks);
-  memory_blocks = node;
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+element_type *
+MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+           alignment>::allocate_contiguous(
+    const std::size_t &n) {
+  // the size of a block of n chunks would overflow
+  if (n == 0 || n > max_chunks())
+    return nullptr;
+  const std::size_t partition_size = alloc_size();
+  void *ret = this->ordered_malloc_n(n, partition_size);
+  if (ret == nullptr)
+    ret = this->carve_n(n);
+  if (ret == nullptr)
+    ret = ordered_malloc_need_resize(n);
+  if (ret != nullptr) {
+    live_chunks += n;
+    this->statistics().on_malloc(n);
+  }
+  return static_cast<element_type *>(ret);
+}
 
-  return static_cast<element_type *>(
-      SimpleSegregatedStorage::memory_pool_malloc());
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+std::size_t
+MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+           alignment>::memory_pool_malloc_n(
+    element_type **chunks, const std::size_t &n) {
+  void **raw_chunks = reinterpret_cast<void **>(chunks);
+  std::size_t taken = 0;
+  while (taken < n) {
+    taken += SimpleSegregatedStorage::memory_pool_malloc_n(raw_chunks + taken,
+                                                           n - taken);
+    for (; taken < n && this->carvable(); taken++)
+      raw_chunks[taken] = this->carve();
+    if (taken == n || (chunks[taken] = malloc_need_resize()) == nullptr)
+      break;
+    taken++;
+  }
+  live_chunks += taken;
+  this->statistics().on_malloc(taken);
+  return taken;
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+template <typename... Args>
+std::size_t
+MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+           alignment>::construct_n(
+    element_type **chunks, const std::size_t &n, const Args &...args) {
+  /*
+   * Construct each chunk right after taking it, the pointer chasing on the
+   * free list hides the cost of the constructor.
+   * */
+  std::size_t taken = 0;
+  try {
+    for (; taken < n; taken++) {
+      element_type *chunk = memory_pool_malloc();
+      if (chunk == nullptr)
+        break;
+      chunks[taken] = chunk;
+      construct_element<element_type>(chunk, args...);
+      this->statistics().on_construct(chunk);
+    }
+  } catch (...) {
+    // the chunk whose constructor throws is not constructed
+    memory_pool_free(chunks[taken]);
+    destroy_n(chunks, taken);
+    throw;
+  }
+  return taken;
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+void MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::destroy_n(
+    element_type *const *chunks, const std::size_t &n) {
+  if (n == 0)
+    return;
+  if constexpr (check_owner) {
+    for (std::size_t i = 0; i < n; i++)
+      check_free(chunks[i]);
+  }
+  element_type *last = chunks[0];
+  this->statistics().on_destroy(last);
+  destroy_element(*last);
+  for (std::size_t i = 1; i < n; i++) {
+    element_type *const chunk = chunks[i];
+    this->statistics().on_destroy(chunk);
+    destroy_element(*chunk);
+    next_of(last) = chunk;
+    last = chunk;
+  }
+  this->memory_pool_free_n(chunks[0], last);
+  count_free(n);
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+void MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::mark_free_chunks(
+    std::vector<BlockBits> &blocks, std::vector<std::uint64_t> &bits) {
+  const std::size_t partition_size = alloc_size();
+  blocks.clear();
+  for (const auto &block : memory_blocks.sorted())
+    blocks.push_back({block.begin, block.end(), 0, 0});
+  std::size_t bit_num = 0;
+  for (auto &block : blocks) {
+    block.first_bit = bit_num;
+    bit_num += (block.end - block.begin) / partition_size;
+  }
+  bits.assign((bit_num + 63) / 64, 0);
+
+  for (void *chunk = this->free_memory; chunk != nullptr;
+       chunk = next_of(chunk)) {
+    char *const address = static_cast<char *>(chunk);
+    auto block = std::upper_bound(blocks.begin(), blocks.end(), address,
+                                  [](char *const ptr, const BlockBits &rhs) {
+                                    return std::less<>()(ptr, rhs.begin);
+                                  }) -
+                 1;
+    const std::size_t bit =
+        block->first_bit + (address - block->begin) / partition_size;
+    bits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    block->free_num++;
+  }
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+bool MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::release_blocks(
+    const std::chrono::steady_clock::time_point &now,
+    const std::chrono::steady_clock::duration &idle_time) {
+  const std::size_t partition_size = alloc_size();
+  std::vector<BlockBits> blocks;
+  std::vector<std::uint64_t> bits;
+  mark_free_chunks(blocks, bits);
+
+  /*
+   * A block is fully free if all of its chunks are in the free list or
+   * behind the bump pointer.
+   * Reuse free_num to mark the blocks to release.
+   * */
+  const std::size_t release_mark = std::numeric_limits<std::size_t>::max();
+  decltype(idle_blocks) still_idle;
+  bool released = false;
+  for (auto &block : blocks) {
+    const bool bump_in_block =
+        this->carvable() && !std::less<>()(this->bump_ptr, block.begin) &&
+        std::less<>()(this->bump_ptr, block.end);
+    std::size_t free_num = block.free_num;
+    if (bump_in_block)
+      free_num += (this->bump_end - this->bump_ptr) / partition_size;
+    if (free_num * partition_size !=
+        static_cast<std::size_t>(block.end - block.begin))
+      continue;
+
+    if (idle_time != idle_time.zero()) {
+      auto found = std::find_if(
+          idle_blocks.begin(), idle_blocks.end(),
+          [&block](const auto &idle) { return idle.first == block.begin; });
+      auto since = found == idle_blocks.end() ? now : found->second;
+      if (now - since < idle_time) {
+        still_idle.emplace_back(block.begin, since);
+        continue;
+      }
+    }
+    if (bump_in_block)
+      this->bump_ptr = this->bump_end = nullptr;
+    block.free_num = release_mark;
+    released = true;
+  }
+  idle_blocks.swap(still_idle);
+  if (!released)
+    return false;
+
+  // link the free chunks of the other blocks again, in address order
+  void *head = nullptr;
+  void **tail = &head;
+  for (auto &block : blocks) {
+    if (block.free_num == release_mark) {
+      const BlockDescriptor released = *memory_blocks.find(block.begin);
+      memory_blocks.remove(block.begin);
+      this->statistics().on_release(released.size, released.size / partition_size);
+      deallocate_block(released);
+      continue;
+    }
+    std::size_t bit = block.first_bit;
+    for (char *i = block.begin; i != block.end; i += partition_size, bit++) {
+      if (test_bit(bits, bit)) {
+        *tail = i;
+        tail = &next_of(i);
+      }
+    }
+  }
+  *tail = nullptr;
+  this->free_memory = head;
+  chunk_num = start_chunk_num;
+  return true;
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+void MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::auto_trim() {
+  trim_countdown = trim_policy.check_interval;
+  const std::size_t chunks = total_chunks();
+  if (static_cast<double>(chunks - live_chunks) <
+      trim_policy.free_fraction * static_cast<double>(chunks)) {
+    // the blocks are busy again, forget when they were idle
+    idle_blocks.clear();
+    return;
+  }
+  release_blocks(std::chrono::steady_clock::now(), trim_policy.idle_time);
+}
+
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+bool MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::reserve(const std::size_t &n) {
+  const std::size_t free_num = total_chunks() - live_chunks;
+  if (free_num >= n)
+    return true;
+
+  const std::size_t partition_size = alloc_size();
+  const std::size_t num_chunks = n - free_num;
+  if (num_chunks > max_chunks())
+    return false;
+  char *ptr = allocate_block(num_chunks);
+  if (ptr == nullptr)
+    return false;
+  // segregate at once, so the burst finds the pages touched already
+  this->add_block(ptr, num_chunks * partition_size, partition_size);
+  return true;
+}
+
+template <typename element_type, typename... Args>
+element_type *construct_element(void *const chunk, Args &&...args) {
+  /*
+   * An array can only be value-initialized, which is also the only way to
+   * construct it without a pseudo constructor call on each element.
+   * */
+  if constexpr (std::is_array<element_type>::value) {
+    static_assert(sizeof...(Args) == 0,
+                  "an array element is constructed without arguments");
+    new (chunk) element_type();
+  } else {
+    new (chunk) element_type(std::forward<Args>(args)...);
+  }
+  return static_cast<element_type *>(chunk);
 }
 
 template <typename element_type> void destroy_element(element_type &ele) {
-  if (!std::has_virtual_destructor<element_type>::value)
-    ele.~element_type();
+  ele.~element_type();
 }
 
 /*
@@ -187,45 +779,96 @@ template <typename element_type> void destroy_element(element_type &ele) {
 template <typename element_type, std::size_t N>
 void destroy_element(element_type (&ele)[N]) {
   for (auto i = N; i > 0; i--) {
-    destroy_element(ele[i]);
+    destroy_element(ele[i - 1]);
   }
 }
 
-template <typename element_type> bool MemoryPool<element_type>::purge_memory() {
-  MemoryBlock iter = memory_blocks;
-  if (!iter.valid())
+template <typename element_type, typename block_provider,
+          typename stats_policy, typename growth_policy,
+          std::size_t alignment>
+bool MemoryPool<element_type, block_provider, stats_policy, growth_policy,
+                alignment>::purge_memory() {
+  if (memory_blocks.empty())
     return false;
 
   /*
-   * Iterate through all memory blocks
+   * Mark the free chunks first, every other chunk holds a live object to
+   * destruct. Then sweep each block linearly.
    * */
-  void *freed_iter = free_memory;
-  const size_t partition_size = alloc_size();
-  do {
-    auto next = iter.next();
-    for (char *i = static_cast<char *>(iter.begin()); i != iter.end();
-         i += partition_size) {
-      if (i == freed_iter) {
-				auto next_node = next_of(freed_iter);
-				// all nodes in this link has been released.
-	      if (freed_iter > next_node)
-		      break;
-
-				freed_iter = next_node;
-				continue;
+  if constexpr (!std::is_trivially_destructible<element_type>::value) {
+    const size_t partition_size = alloc_size();
+    std::vector<BlockBits> blocks;
+    std::vector<std::uint64_t> bits;
+    mark_free_chunks(blocks, bits);
+    for (auto &block : blocks) {
+      // the chunks behind the bump pointer have never been constructed, but
+      // the bump pointer only stops the sweep of the block it's in
+      char *end = block.end;
+      if (this->carvable() && !std::less<>()(this->bump_ptr, block.begin) &&
+          std::less<>()(this->bump_ptr, block.end))
+        end = this->bump_ptr;
+      std::size_t bit = block.first_bit;
+      for (char *i = block.begin; i != end; i += partition_size, bit++) {
+        if (!test_bit(bits, bit))
+          destroy_element(*reinterpret_cast<element_type *>(i));
       }
-      if (freed_iter == nullptr)
-        break;
-      destroy_element(reinterpret_cast<element_type &>(i));
     }
-    free(iter.begin());
-    iter = next;
-  } while (iter.valid());
+  }
 
-  memory_blocks.invalidate();
+  for (const auto &block : memory_blocks)
+    deallocate_block(block);
+
+  memory_blocks.clear();
   this->free_memory = nullptr;
+  this->bump_ptr = this->bump_end = nullptr;
+  live_chunks = 0;
+  idle_blocks.clear();
+  this->statistics().on_purge();
   return true;
 }
+
+/*
+ * A memory pool handing out raw chunks with the size and alignment of
+ * element_type. Nothing is constructed or destructed in the chunks, so it's
+ * the building block of the other pools that manage objects by themselves.
+ * */
+template <typename element_type,
+          typename block_provider = MallocBlockProvider,
+          typename stats_policy = NoStats,
+          typename growth_policy = GeometricGrowth<>,
+          std::size_t alignment = alignof(element_type)>
+class RawMemoryPool
+    : public MemoryPool<std::aligned_storage_t<sizeof(element_type),
+                                               alignof(element_type)>,
+                        block_provider, stats_policy, growth_policy,
+                        alignment> {
+  typedef std::aligned_storage_t<sizeof(element_type), alignof(element_type)>
+      storage_type;
+
+public:
+  explicit RawMemoryPool(const std::size_t &chunks_num_val = 32,
+                         const std::size_t &max_chunks_val = 0,
+                         const bool &lazy_segregation_val = false,
+                         const block_provider &provider_val = block_provider())
+      : MemoryPool<storage_type, block_provider, stats_policy, growth_policy,
+                   alignment>(chunks_num_val, max_chunks_val,
+                              lazy_segregation_val, provider_val) {}
+
+  void *malloc_chunk() { return this->memory_pool_malloc(); }
+
+  /*
+   * Take up to n chunks at once, return the number of chunks taken.
+   * */
+  std::size_t malloc_chunks(void **chunks, const std::size_t &n) {
+    return this->memory_pool_malloc_n(reinterpret_cast<storage_type **>(chunks),
+                                      n);
+  }
+
+  void free_chunk(void *const chunk) {
+    this->check_free(chunk);
+    this->memory_pool_free(static_cast<storage_type *>(chunk));
+  }
+};
 } // namespace memory_pool
 
 #endif // MEMORY_POOL_H
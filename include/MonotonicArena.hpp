@@ -0,0 +1,153 @@
+/*
+ * @author: Pei Mu
+ * @description: Monotonic arena over the memory block chain
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+
+#include "BlockProvider.hpp"
+#include "MemoryBlock.hpp"
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace memory_pool {
+/*
+ * An arena for the objects living and dying together, e.g. all objects of a
+ * request. construct() bumps a pointer through the blocks, there is no
+ * destroy() for one object, and reset() drops all objects at once.
+ * The blocks are kept in the order they are allocated, reset() rewinds to
+ * the first one, and the next round reuses them before allocating more.
+ * Trivially destructible objects are not visited at all, so reset() is O(1);
+ * otherwise every object is destructed in the order of construction.
+ * The objects are bumped from the begin of each block, so element_type can't
+ * be aligned more than the blocks of block_provider.
+ * */
+template <typename element_type,
+          typename block_provider = MallocBlockProvider>
+class MonotonicArena {
+  static_assert(alignof(element_type) <=
+                    block_alignment_of<block_provider>::value,
+                "the element is aligned more than the blocks of the provider");
+
+public:
+  explicit MonotonicArena(const std::size_t &chunks_num_val = 32,
+                          const block_provider &provider_val = block_provider())
+      : chunk_num(std::min(std::max<std::size_t>(chunks_num_val, 1),
+                           max_chunks())),
+        provider(provider_val) {}
+
+  MonotonicArena(const MonotonicArena &) = delete;
+  MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+  ~MonotonicArena() {
+    reset();
+    MemoryBlock iter = first_block;
+    while (iter.valid()) {
+      auto next = iter.next();
+      provider.deallocate(iter.begin(), iter.total_size());
+      iter = next;
+    }
+  }
+
+  template <typename... Args> element_type *construct(Args &&...args) {
+    if (bump_ptr == bump_end && !next_block())
+      return nullptr;
+    element_type *const ret = construct_element<element_type>(
+        bump_ptr, std::forward<Args>(args)...);
+    bump_ptr += partition_size;
+    return ret;
+  }
+
+  /*
+   * Destruct all objects, and rewind to the first block.
+   * The memory is kept for the next round.
+   * */
+  void reset() {
+    if constexpr (!std::is_trivially_destructible<element_type>::value) {
+      MemoryBlock iter = current_block.valid() ? first_block : MemoryBlock();
+      for (; iter.valid(); iter = iter.next()) {
+        const bool current = iter.begin() == current_block.begin();
+        char *const end = current ? bump_ptr : chunks_end(iter);
+        for (char *i = static_cast<char *>(iter.begin()); i != end;
+             i += partition_size)
+          destroy_element(*reinterpret_cast<element_type *>(i));
+        if (current)
+          break;
+      }
+    }
+    current_block = MemoryBlock();
+    bump_ptr = bump_end = nullptr;
+  }
+
+private:
+  /*
+   * Move the bump pointer to the block after the current one, allocate it
+   * if it is not there yet.
+   * */
+  bool next_block() {
+    MemoryBlock next;
+    if (!current_block.valid())
+      next = first_block;
+    else
+      next = current_block.next();
+
+    if (!next.valid()) {
+      // the footer of the block needs the alignment of a pointer
+      std::size_t block_size = chunk_num * partition_size;
+      block_size += (alignof(void *) - block_size % alignof(void *)) %
+                    alignof(void *);
+      block_size += MemoryBlock::footer_size();
+      void *const ptr = provider.allocate(block_size);
+      if (ptr == nullptr)
+        return false;
+      next = MemoryBlock(ptr, block_size);
+      next.next(MemoryBlock());
+      if (current_block.valid())
+        current_block.next(next);
+      else
+        first_block = next;
+      chunk_num =
+          chunk_num > max_chunks() / 2 ? max_chunks() : chunk_num << 1;
+    }
+
+    current_block = next;
+    bump_ptr = static_cast<char *>(current_block.begin());
+    bump_end = chunks_end(current_block);
+    return true;
+  }
+
+  static char *chunks_end(MemoryBlock &block) {
+    return static_cast<char *>(block.begin()) +
+           block.element_size() / partition_size * partition_size;
+  }
+
+  static constexpr std::size_t partition_size = sizeof(element_type);
+
+  /*
+   * The most chunks of a block whose size, with the padding and the footer,
+   * doesn't overflow.
+   * */
+  static constexpr std::size_t max_chunks() {
+    return (std::numeric_limits<std::size_t>::max() - alignof(void *) -
+            MemoryBlock::footer_size()) /
+           partition_size;
+  }
+
+  /*
+   * The blocks are linked from the first allocated to the last one.
+   * */
+  MemoryBlock first_block;
+  MemoryBlock current_block;
+  char *bump_ptr = nullptr;
+  char *bump_end = nullptr;
+  std::size_t chunk_num;
+  block_provider provider;
+};
+} // namespace memory_pool
+
+#endif // MONOTONIC_ARENA_H
@@ -0,0 +1,219 @@
+/*
+ * @author: Pei Mu
+ * @description: NUMA-aware memory pool with a pool per node
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef NUMA_MEMORY_POOL_H
+#define NUMA_MEMORY_POOL_H
+
+#include "BlockProvider.hpp"
+#include "MemoryPool.hpp"
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace memory_pool {
+/*
+ * Find the NUMA node of the calling thread with getcpu, and the number of
+ * nodes from sysfs. A node locator needs node_num() and current_node() only,
+ * so tests can simulate the nodes.
+ * */
+class CpuNodeLocator {
+public:
+  CpuNodeLocator() {
+    FILE *possible = fopen("/sys/devices/system/node/possible", "r");
+    if (possible == nullptr)
+      return;
+    // e.g. "0" or "0-1"
+    unsigned first = 0, last = 0;
+    int matched = fscanf(possible, "%u-%u", &first, &last);
+    if (matched == 2)
+      nodes = last + 1;
+    else if (matched == 1)
+      nodes = first + 1;
+    fclose(possible);
+  }
+
+  unsigned node_num() const { return nodes; }
+
+  unsigned current_node() const {
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= nodes)
+      return 0;
+    return node;
+  }
+
+private:
+  unsigned nodes = 1;
+};
+
+/*
+ * The address ranges of the blocks of each node, so a chunk freed by a
+ * thread of another node goes back to the node it belongs to.
+ * */
+class NumaBlockRegistry {
+public:
+  void add(void *const block, const std::size_t &size, const unsigned &node) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    auto begin = reinterpret_cast<std::uintptr_t>(block);
+    blocks[begin] = {begin + size, node};
+  }
+
+  void remove(void *const block) {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    blocks.erase(reinterpret_cast<std::uintptr_t>(block));
+  }
+
+  /*
+   * Return the node of the block holding chunk, or -1 if there is no one.
+   * */
+  int find(const void *const chunk) const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    auto address = reinterpret_cast<std::uintptr_t>(chunk);
+    auto iter = blocks.upper_bound(address);
+    if (iter == blocks.begin())
+      return -1;
+    --iter;
+    return address < iter->second.first ? static_cast<int>(iter->second.second)
+                                        : -1;
+  }
+
+private:
+  mutable std::shared_mutex lock;
+  std::map<std::uintptr_t, std::pair<std::uintptr_t, unsigned>> blocks;
+};
+
+/*
+ * Map the blocks with MmapBlockProvider and bind them to a node with mbind,
+ * before any page is touched. Binding is best-effort: if the kernel rejects
+ * it (e.g. no such node), the block is still used without the policy.
+ * MAP_POPULATE would fault the pages before the binding, so with
+ * MmapBlockProvider::populate the pages are pre-faulted after it instead.
+ * */
+class NumaBlockProvider {
+public:
+  static constexpr std::size_t block_alignment =
+      MmapBlockProvider::block_alignment;
+
+  NumaBlockProvider(const unsigned &node_val, NumaBlockRegistry *registry_val,
+                    const unsigned &mmap_flags = MmapBlockProvider::none)
+      : provider(mmap_flags & ~MmapBlockProvider::populate), node(node_val),
+        prefault(mmap_flags & MmapBlockProvider::populate),
+        registry(registry_val) {}
+
+  void *allocate(const std::size_t &size) {
+    void *const block = provider.allocate(size);
+    if (block == nullptr)
+      return nullptr;
+    bind(block, provider.mapped_size(size));
+    if (prefault)
+      populate(block, provider.mapped_size(size));
+    registry->add(block, size, node);
+    return block;
+  }
+
+  void deallocate(void *const block, const std::size_t &size) {
+    registry->remove(block);
+    provider.deallocate(block, size);
+  }
+
+private:
+  void bind(void *const block, const std::size_t &size) const {
+#ifdef SYS_mbind
+    const unsigned long bind_policy = 2; // MPOL_BIND
+    unsigned long node_mask[4] = {};
+    const std::size_t mask_bits = sizeof(node_mask) * 8;
+    if (node >= mask_bits)
+      return;
+    node_mask[node / (sizeof(unsigned long) * 8)] =
+        1ul << (node % (sizeof(unsigned long) * 8));
+    syscall(SYS_mbind, block, size, bind_policy, node_mask, mask_bits, 0);
+#endif
+  }
+
+  /*
+   * Touch one byte per page, so the pages are faulted on the bound node.
+   * */
+  static void populate(void *const block, const std::size_t &size) {
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    for (std::size_t offset = 0; offset < size; offset += page_size)
+      static_cast<volatile char *>(block)[offset] = 0;
+  }
+
+  MmapBlockProvider provider;
+  unsigned node;
+  bool prefault;
+  NumaBlockRegistry *registry;
+};
+
+/*
+ * A memory pool per NUMA node, and each node grows its own blocks bound to
+ * its memory. construct() serves the caller from the free list of its own
+ * node, and destroy() gives the chunk back to the node it was allocated
+ * from, even if the caller runs on another node.
+ * The pool is thread-safe, each node has its own lock.
+ * */
+template <typename element_type, typename node_locator = CpuNodeLocator>
+class NumaMemoryPool {
+public:
+  explicit NumaMemoryPool(const std::size_t &chunks_num_val = 32,
+                          const std::size_t &max_chunks_val = 0,
+                          const node_locator &locator_val = node_locator(),
+                          const unsigned &mmap_flags = MmapBlockProvider::none)
+      : locator(locator_val) {
+    for (unsigned node = 0; node < locator.node_num(); node++)
+      nodes.emplace_back(std::make_unique<Node>(
+          chunks_num_val, max_chunks_val,
+          NumaBlockProvider(node, &registry, mmap_flags)));
+  }
+
+  template <typename... Args> element_type *construct(Args &&...args) {
+    Node &node = *nodes[locator.current_node()];
+    std::lock_guard<std::mutex> guard(node.lock);
+    return node.pool.construct(std::forward<Args>(args)...);
+  }
+
+  void destroy(element_type *const chunk) {
+    Node &node = *nodes[node_of(chunk)];
+    std::lock_guard<std::mutex> guard(node.lock);
+    node.pool.destroy(chunk);
+  }
+
+  /*
+   * The node a chunk is allocated from.
+   * Throw std::invalid_argument if the chunk is not from this pool.
+   * */
+  unsigned node_of(const element_type *const chunk) const {
+    const int node = registry.find(chunk);
+    if (node < 0)
+      throw std::invalid_argument("the chunk is not from this pool");
+    return static_cast<unsigned>(node);
+  }
+
+  unsigned node_num() const { return static_cast<unsigned>(nodes.size()); }
+
+private:
+  struct Node {
+    Node(const std::size_t &chunks_num_val, const std::size_t &max_chunks_val,
+         const NumaBlockProvider &provider)
+        : pool(chunks_num_val, max_chunks_val, false, provider) {}
+
+    std::mutex lock;
+    MemoryPool<element_type, NumaBlockProvider> pool;
+  };
+
+  node_locator locator;
+  // the registry outlives the pools, which unregister their blocks
+  NumaBlockRegistry registry;
+  std::vector<std::unique_ptr<Node>> nodes;
+};
+} // namespace memory_pool
+
+#endif // NUMA_MEMORY_POOL_H
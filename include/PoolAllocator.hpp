@@ -0,0 +1,114 @@
+/*
+ * @author: Pei Mu
+ * @description: STL-compatible node allocator over the memory pool
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include "MemoryPool.hpp"
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+namespace memory_pool {
+/*
+ * A mutex doing nothing, for the pools only used by one thread.
+ * */
+struct NullMutex {
+  void lock() {}
+  void unlock() {}
+};
+
+/*
+ * A process-wide memory pool for the chunks of the given size and alignment.
+ * The pool is never destroyed on purpose, so containers destroyed by the
+ * static destructors can still give their nodes back.
+ * */
+template <std::size_t size, std::size_t alignment, typename mutex_type>
+class SingletonPool {
+public:
+  static void *malloc_chunk() {
+    SingletonPool &singleton = instance();
+    std::lock_guard<mutex_type> guard(singleton.lock);
+    return singleton.pool.malloc_chunk();
+  }
+
+  static void free_chunk(void *const chunk) {
+    SingletonPool &singleton = instance();
+    std::lock_guard<mutex_type> guard(singleton.lock);
+    singleton.pool.free_chunk(chunk);
+  }
+
+private:
+  SingletonPool() = default;
+
+  static SingletonPool &instance() {
+    static SingletonPool *const singleton = new SingletonPool();
+    return *singleton;
+  }
+
+  mutex_type lock;
+  RawMemoryPool<std::aligned_storage_t<size, alignment>> pool;
+};
+
+/*
+ * An allocator for the node-based containers (std::list, std::map,
+ * std::set, etc.).
+ * The containers rebind it to their node type, so the pool serves the real
+ * nodes rather than element_type, and all node types of the same size and
+ * alignment share one SingletonPool.
+ * Arrays (n > 1) are not pooled, they go to std::allocator.
+ * */
+template <typename element_type, typename mutex_type = std::mutex>
+class PoolAllocator {
+  typedef SingletonPool<sizeof(element_type), alignof(element_type),
+                        mutex_type>
+      pool_type;
+
+public:
+  typedef element_type value_type;
+  typedef std::true_type is_always_equal;
+
+  template <typename other_type> struct rebind {
+    typedef PoolAllocator<other_type, mutex_type> other;
+  };
+
+  PoolAllocator() noexcept = default;
+
+  template <typename other_type>
+  PoolAllocator(const PoolAllocator<other_type, mutex_type> &) noexcept {}
+
+  element_type *allocate(const std::size_t n) {
+    if (n != 1)
+      return std::allocator<element_type>().allocate(n);
+    void *const ret = pool_type::malloc_chunk();
+    if (ret == nullptr)
+      throw std::bad_alloc();
+    return static_cast<element_type *>(ret);
+  }
+
+  void deallocate(element_type *const chunk, const std::size_t n) {
+    if (n != 1)
+      std::allocator<element_type>().deallocate(chunk, n);
+    else
+      pool_type::free_chunk(chunk);
+  }
+};
+
+template <typename type1, typename type2, typename mutex_type>
+bool operator==(const PoolAllocator<type1, mutex_type> &,
+                const PoolAllocator<type2, mutex_type> &) {
+  return true;
+}
+
+template <typename type1, typename type2, typename mutex_type>
+bool operator!=(const PoolAllocator<type1, mutex_type> &,
+                const PoolAllocator<type2, mutex_type> &) {
+  return false;
+}
+} // namespace memory_pool
+
+#endif // POOL_ALLOCATOR_H
@@ -0,0 +1,77 @@
+/*
+ * @author: Pei Mu
+ * @description: std::pmr::memory_resource over the size-class pool
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef POOL_MEMORY_RESOURCE_H
+#define POOL_MEMORY_RESOURCE_H
+
+#include "SizeClassPool.hpp"
+#include <memory_resource>
+
+namespace memory_pool {
+/*
+ * A memory resource for the std::pmr containers.
+ * Every do_allocate(bytes, alignment) goes to the size class of bytes, so the
+ * nodes of std::pmr::list, std::pmr::map, std::pmr::unordered_map, etc. come
+ * from the segregated storages instead of one malloc per node.
+ * Requests bigger than SizeClassPool::max_size, or aligned stricter than
+ * their size class, go to the upstream resource.
+ *
+ * Like std::pmr::unsynchronized_pool_resource, it is not thread-safe, and all
+ * memory is released when the resource is destroyed.
+ * */
+class PoolMemoryResource : public std::pmr::memory_resource {
+public:
+  explicit PoolMemoryResource(
+      std::pmr::memory_resource *const upstream_val =
+          std::pmr::get_default_resource())
+      : upstream(upstream_val) {}
+
+  PoolMemoryResource(const PoolMemoryResource &) = delete;
+  PoolMemoryResource &operator=(const PoolMemoryResource &) = delete;
+
+  std::pmr::memory_resource *upstream_resource() const { return upstream; }
+
+  /*
+   * Release the memory of all size classes, even if it is still in use.
+   * */
+  void release() { pool.purge_memory(); }
+
+protected:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (!pooled(bytes, alignment))
+      return upstream->allocate(bytes, alignment);
+    void *const ret = pool.allocate(bytes);
+    if (ret == nullptr)
+      throw std::bad_alloc();
+    return ret;
+  }
+
+  void do_deallocate(void *chunk, std::size_t bytes,
+                     std::size_t alignment) override {
+    if (!pooled(bytes, alignment))
+      upstream->deallocate(chunk, bytes, alignment);
+    else
+      pool.deallocate(chunk, bytes);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+private:
+  static bool pooled(const std::size_t &bytes, const std::size_t &alignment) {
+    return bytes <= SizeClassPool::max_size &&
+           alignment <= SizeClassPool::class_alignment(
+                            SizeClassPool::class_index(bytes));
+  }
+
+  std::pmr::memory_resource *const upstream;
+  SizeClassPool pool;
+};
+} // namespace memory_pool
+
+#endif // POOL_MEMORY_RESOURCE_H
@@ -0,0 +1,105 @@
+/*
+ * @author: Pei Mu
+ * @description: Smart pointers to the objects of the memory pools
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef POOL_PTR_H
+#define POOL_PTR_H
+
+#include "MemoryPool.hpp"
+#include "PoolAllocator.hpp"
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace memory_pool {
+/*
+ * Destroy an object in the pool it is constructed from. The deleter only
+ * holds the pool, so a pool_unique_ptr is two pointers.
+ * */
+template <typename element_type, typename pool_type = MemoryPool<element_type>>
+class PoolDeleter {
+public:
+  PoolDeleter() noexcept = default;
+  explicit PoolDeleter(pool_type *pool_val) noexcept : pool(pool_val) {}
+
+  void operator()(element_type *const ptr) const { pool->destroy(ptr); }
+
+  pool_type *get_pool() const noexcept { return pool; }
+
+private:
+  pool_type *pool = nullptr;
+};
+
+template <typename element_type, typename pool_type = MemoryPool<element_type>>
+using pool_unique_ptr =
+    std::unique_ptr<element_type, PoolDeleter<element_type, pool_type>>;
+
+/*
+ * Construct an object in pool owned by a pool_unique_ptr, which must not
+ * outlive the pool. Throw std::bad_alloc if the pool is full.
+ * */
+template <typename element_type, typename pool_type, typename... Args>
+pool_unique_ptr<element_type, pool_type> make_pool_unique(pool_type &pool,
+                                                          Args &&...args) {
+  element_type *const ptr = pool.construct(std::forward<Args>(args)...);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return pool_unique_ptr<element_type, pool_type>(
+      ptr, PoolDeleter<element_type, pool_type>(&pool));
+}
+
+/*
+ * Destroy an object in the SingletonPool of PoolAllocator. The deleter is
+ * stateless, so a singleton_unique_ptr is as small as a raw pointer.
+ * */
+template <typename element_type, typename mutex_type = std::mutex>
+struct SingletonPoolDeleter {
+  void operator()(element_type *const ptr) const {
+    ptr->~element_type();
+    PoolAllocator<element_type, mutex_type>().deallocate(ptr, 1);
+  }
+};
+
+template <typename element_type, typename mutex_type = std::mutex>
+using singleton_unique_ptr =
+    std::unique_ptr<element_type,
+                    SingletonPoolDeleter<element_type, mutex_type>>;
+
+/*
+ * Construct an object in the SingletonPool of its size and alignment, owned
+ * by a singleton_unique_ptr.
+ * */
+template <typename element_type, typename mutex_type = std::mutex,
+          typename... Args>
+singleton_unique_ptr<element_type, mutex_type>
+make_singleton_unique(Args &&...args) {
+  PoolAllocator<element_type, mutex_type> allocator;
+  element_type *const ptr = allocator.allocate(1);
+  try {
+    ::new (static_cast<void *>(ptr))
+        element_type(std::forward<Args>(args)...);
+  } catch (...) {
+    allocator.deallocate(ptr, 1);
+    throw;
+  }
+  return singleton_unique_ptr<element_type, mutex_type>(ptr);
+}
+
+/*
+ * The pooled std::make_shared: the control block and the object are
+ * allocated together, in the SingletonPool sized for the composite, as
+ * std::allocate_shared rebinds PoolAllocator to it.
+ * The last owner may be on any thread, so the pool is locked by default.
+ * */
+template <typename element_type, typename mutex_type = std::mutex,
+          typename... Args>
+std::shared_ptr<element_type> pool_allocate_shared(Args &&...args) {
+  return std::allocate_shared<element_type>(
+      PoolAllocator<element_type, mutex_type>(), std::forward<Args>(args)...);
+}
+} // namespace memory_pool
+
+#endif // POOL_PTR_H
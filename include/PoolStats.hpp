@@ -0,0 +1,175 @@
+/*
+ * @author: Pei Mu
+ * @description: Statistics policies of the memory pool
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef POOL_STATS_H
+#define POOL_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace memory_pool {
+/*
+ * A statistics policy is told about every event of the pool:
+ *  init(chunk_size): the pool is created;
+ *  on_malloc(n), on_free(n): n chunks are handed out or given back;
+ *  on_resize(block_size, chunks): a block is allocated;
+ *  on_release(block_size, chunks): a block is given back to the system;
+ *  on_purge(): all blocks are given back;
+ *  on_construct(chunk), on_destroy(chunk): an object is constructed in or
+ *                                          destroyed from chunk.
+ * */
+
+/*
+ * The default policy, compiled out completely.
+ * */
+struct NoStats {
+  void init(const std::size_t &) {}
+  void on_malloc(const std::size_t &) {}
+  void on_free(const std::size_t &) {}
+  void on_resize(const std::size_t &, const std::size_t &) {}
+  void on_release(const std::size_t &, const std::size_t &) {}
+  void on_purge() {}
+  void on_construct(const void *) {}
+  void on_destroy(const void *) {}
+};
+
+/*
+ * Count the events with relaxed atomics, so the counters can be read from
+ * another thread (e.g. a metrics scraper) while the pool is in use.
+ * The numbers read together are not a consistent snapshot, the free chunk
+ * number is only an estimate of the free list length.
+ * */
+class PoolStats {
+public:
+  void init(const std::size_t &chunk_size_val) { chunk_size = chunk_size_val; }
+
+  void on_malloc(const std::size_t &n) {
+    const std::size_t live =
+        live_num.fetch_add(n, std::memory_order_relaxed) + n;
+    // a plain store could overwrite a higher peak set at the same time
+    std::size_t peak = peak_num.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peak_num.compare_exchange_weak(peak, live,
+                                           std::memory_order_relaxed))
+      ;
+  }
+
+  void on_free(const std::size_t &n) {
+    live_num.fetch_sub(n, std::memory_order_relaxed);
+  }
+
+  void on_resize(const std::size_t &block_size, const std::size_t &chunks) {
+    block_num.fetch_add(1, std::memory_order_relaxed);
+    reserved.fetch_add(block_size, std::memory_order_relaxed);
+    total_chunks.fetch_add(chunks, std::memory_order_relaxed);
+    const std::size_t index =
+        resize_num.fetch_add(1, std::memory_order_relaxed);
+    const auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    resize_times[index % resize_history].store(now.count(),
+                                               std::memory_order_relaxed);
+  }
+
+  void on_release(const std::size_t &block_size, const std::size_t &chunks) {
+    block_num.fetch_sub(1, std::memory_order_relaxed);
+    reserved.fetch_sub(block_size, std::memory_order_relaxed);
+    total_chunks.fetch_sub(chunks, std::memory_order_relaxed);
+  }
+
+  void on_purge() {
+    live_num.store(0, std::memory_order_relaxed);
+    block_num.store(0, std::memory_order_relaxed);
+    reserved.store(0, std::memory_order_relaxed);
+    total_chunks.store(0, std::memory_order_relaxed);
+  }
+
+  void on_construct(const void *) {}
+  void on_destroy(const void *) {}
+
+  std::size_t live() const { return live_num.load(std::memory_order_relaxed); }
+
+  std::size_t peak() const { return peak_num.load(std::memory_order_relaxed); }
+
+  std::size_t blocks() const {
+    return block_num.load(std::memory_order_relaxed);
+  }
+
+  std::size_t reserved_bytes() const {
+    return reserved.load(std::memory_order_relaxed);
+  }
+
+  std::size_t used_bytes() const { return live() * chunk_size; }
+
+  std::size_t free_chunks() const {
+    const std::size_t total = total_chunks.load(std::memory_order_relaxed);
+    const std::size_t used = live();
+    return total > used ? total - used : 0;
+  }
+
+  std::size_t resizes() const {
+    return resize_num.load(std::memory_order_relaxed);
+  }
+
+  /*
+   * The time of the index-th latest resize, in microseconds since the epoch.
+   * Only the latest resize_history resizes are kept.
+   * */
+  std::int64_t resize_time(const std::size_t &index) const {
+    const std::size_t num = resizes();
+    if (index >= num || index >= resize_history)
+      return 0;
+    return resize_times[(num - 1 - index) % resize_history].load(
+        std::memory_order_relaxed);
+  }
+
+  std::string to_json() const {
+    std::string json = "{";
+    json += "\"chunk_size\":" + std::to_string(chunk_size);
+    json += ",\"live\":" + std::to_string(live());
+    json += ",\"peak\":" + std::to_string(peak());
+    json += ",\"blocks\":" + std::to_string(blocks());
+    json += ",\"reserved_bytes\":" + std::to_string(reserved_bytes());
+    json += ",\"used_bytes\":" + std::to_string(used_bytes());
+    json += ",\"free_chunks\":" + std::to_string(free_chunks());
+    json += ",\"resizes\":" + std::to_string(resizes());
+    json += ",\"resize_times_us\":[";
+    for (std::size_t i = 0; i < resizes() && i < resize_history; i++) {
+      if (i)
+        json += ",";
+      json += std::to_string(resize_time(i));
+    }
+    json += "]}";
+    return json;
+  }
+
+  static constexpr std::size_t resize_history = 16;
+
+private:
+  std::size_t chunk_size = 0;
+  std::atomic<std::size_t> live_num{0};
+  std::atomic<std::size_t> peak_num{0};
+  std::atomic<std::size_t> block_num{0};
+  std::atomic<std::size_t> reserved{0};
+  std::atomic<std::size_t> total_chunks{0};
+  std::atomic<std::size_t> resize_num{0};
+  std::atomic<std::int64_t> resize_times[resize_history] = {};
+};
+
+/*
+ * The pool inherits its stats policy through this holder instead of storing
+ * it as a member, so an empty policy like NoStats takes no space (empty base
+ * optimization).
+ * */
+template <typename stats_policy> class StatsHolder : private stats_policy {
+protected:
+  stats_policy &statistics() { return *this; }
+  const stats_policy &statistics() const { return *this; }
+};
+} // namespace memory_pool
+
+#endif // POOL_STATS_H
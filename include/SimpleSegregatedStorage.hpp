@@ -8,6 +8,8 @@
 #define SIMPLE_SEGREGATED_STORAGE_H
 
 #include <cassert>
+#include <cstddef>
+#include <functional>
 
 namespace memory_pool {
 /*
@@ -17,7 +19,17 @@ namespace memory_pool {
  * */
 class SimpleSegregatedStorage {
 public:
-  SimpleSegregatedStorage() : free_memory(nullptr) {}
+  SimpleSegregatedStorage()
+      : free_memory(nullptr), bump_ptr(nullptr), bump_end(nullptr),
+        bump_size(0) {}
+
+  /*
+   * Segregate block into chunks, and link the last chunk to end.
+   * Return the first chunk of the linked list.
+   * */
+  static void *segregate(void *block, const std::size_t &total_size,
+                         const std::size_t &partition_size,
+                         void *end = nullptr);
 
 protected:
   /*
@@ -28,6 +40,62 @@ protected:
     free_memory = segregate(block, size, partition_size, free_memory);
   }
 
+  /*
+   * Add a block without segregating it.
+   * The chunks are carved from the bump pointer only when the free list is
+   * empty, and they join the free list after they are freed. So the pages of
+   * a big block are not touched before they are really used.
+   * */
+  void add_block_lazy(void *const block, const std::size_t &size,
+                      const std::size_t &partition_size) {
+    // the rest of the last lazy block is not lost
+    if (bump_ptr != bump_end)
+      free_memory = segregate(bump_ptr, bump_end - bump_ptr, bump_size,
+                              free_memory);
+    bump_ptr = static_cast<char *>(block);
+    bump_end = bump_ptr + (size / partition_size) * partition_size;
+    bump_size = partition_size;
+  }
+
+  /*
+   * Check if there are chunks left behind the bump pointer.
+   * */
+  bool carvable() const { return bump_ptr != bump_end; }
+
+  /*
+   * Carve a chunk from the bump pointer.
+   * */
+  void *carve() {
+    void *const ret = bump_ptr;
+    bump_ptr += bump_size;
+    used_up();
+    return ret;
+  }
+
+  /*
+   * Carve n contiguous chunks from the bump pointer.
+   * Return nullptr if there are not enough chunks left.
+   * */
+  void *carve_n(const std::size_t &n) {
+    // divide instead of multiplying, a huge n cannot wrap around
+    if (!carvable() ||
+        n > static_cast<std::size_t>(bump_end - bump_ptr) / bump_size)
+      return nullptr;
+    void *const ret = bump_ptr;
+    bump_ptr += n * bump_size;
+    used_up();
+    return ret;
+  }
+
+  /*
+   * Clear the bump pointer once the lazy block is used up, otherwise it
+   * points at the end of the block, which can be the begin of the next one.
+   * */
+  void used_up() {
+    if (bump_ptr == bump_end)
+      bump_ptr = bump_end = nullptr;
+  }
+
   /*
    * Malloc method of the simple segregated storage.
    * */
@@ -38,12 +106,60 @@ protected:
    * */
   void memory_pool_free(void *chunk);
 
+  /*
+   * Take up to n chunks from the free list, and write them to chunks.
+   * Return the number of chunks taken.
+   * */
+  std::size_t memory_pool_malloc_n(void **chunks, const std::size_t &n);
+
+  /*
+   * Splice a linked list of chunks from first to last back to the free list.
+   * */
+  void memory_pool_free_n(void *first, void *last);
+
+  /*
+   * The ordered interfaces keep the free list sorted by address, so that
+   * adjacent free chunks are adjacent in the free list as well.
+   * Add a segregated block to the right place of the free list.
+   * */
+  void add_ordered_block(void *const block, const std::size_t &size,
+                         const std::size_t &partition_size) {
+    void *const loc = find_prev(block);
+    if (loc == nullptr)
+      add_block(block, size, partition_size);
+    else
+      next_of(loc) = segregate(block, size, partition_size, next_of(loc));
+  }
+
+  /*
+   * Free a chunk to the right place of the free list.
+   * */
+  void ordered_free(void *chunk);
+
+  /*
+   * Free n contiguous chunks to the right place of the free list.
+   * */
+  void ordered_free_n(void *chunks, const std::size_t &n,
+                      const std::size_t &partition_size) {
+    add_ordered_block(chunks, n * partition_size, partition_size);
+  }
+
+  /*
+   * Find n contiguous chunks in the ordered free list, and take them.
+   * Return nullptr if there are no such chunks.
+   * */
+  void *ordered_malloc_n(const std::size_t &n,
+                         const std::size_t &partition_size);
+
   /*
    * Establish a link with the next node.
    * It's a very tricky idea to store the address content by pointed address.
-   * [hint] A bug here for very small partition size (e.g. <= 5 bytes).
+   * So a chunk must hold a pointer, MemoryPool rounds the partition size up
+   * to it, and SmallObjectPool serves the elements smaller than a pointer.
    * */
-  void *&next_of(void *const ptr) { return *(static_cast<void **>(ptr)); }
+  static void *&next_of(void *const ptr) {
+    return *(static_cast<void **>(ptr));
+  }
 
   /*
    * Find the previous node by iterating from back to begin.
@@ -56,23 +172,32 @@ protected:
    * */
 	void *free_memory;
 
- private:
-	/*
-   * Segregate block into chunks
+  /*
+   * The chunks of the lazy block that have never been handed out,
+   * in [bump_ptr, bump_end).
    * */
-	void *segregate(void *block, const std::size_t &total_size,
-	                const std::size_t &partition_size, void *end);
+  char *bump_ptr;
+  char *bump_end;
+  std::size_t bump_size;
 
+ private:
   /*
    * Check if the memory list is empty.
    * */
   bool empty() { return (free_memory == nullptr); }
+
+  /*
+   * Check if n chunks are linked contiguously after start.
+   * Return the last of them, or nullptr and move start to the last checked
+   * chunk so that the search goes on from there.
+   * */
+  static void *try_malloc_n(void *&start, std::size_t n,
+                            const std::size_t &partition_size);
 };
 
-void *SimpleSegregatedStorage::segregate(void *block,
-                                         const std::size_t &total_size,
-                                         const std::size_t &partition_size,
-                                         void *end) {
+inline void *SimpleSegregatedStorage::segregate(
+    void *block, const std::size_t &total_size,
+    const std::size_t &partition_size, void *end) {
   // get pointer to the last valid chunk
   // last_chunk == block + partition_size * i
   char *last_chunk =
@@ -98,20 +223,83 @@ void *SimpleSegregatedStorage::segregate(void *block,
   return block;
 }
 
-void *SimpleSegregatedStorage::memory_pool_malloc() {
+inline void *SimpleSegregatedStorage::memory_pool_malloc() {
   void *const ret = free_memory;
   // increase the "free_memory" pointer to point to the next chunk
   free_memory = next_of(free_memory);
   return ret;
 }
 
-void SimpleSegregatedStorage::memory_pool_free(void *chunk) {
+inline void SimpleSegregatedStorage::memory_pool_free(void *chunk) {
   // reduce the "free_memory" pointer to the previous node
   next_of(chunk) = free_memory;
   free_memory = chunk;
 }
 
-void *SimpleSegregatedStorage::find_prev(void *ptr) {
+inline std::size_t
+SimpleSegregatedStorage::memory_pool_malloc_n(void **chunks,
+                                              const std::size_t &n) {
+  std::size_t taken = 0;
+  void *iter = free_memory;
+  while (taken < n && iter != nullptr) {
+    chunks[taken++] = iter;
+    iter = next_of(iter);
+  }
+  // cut the taken chunks off with a single write
+  free_memory = iter;
+  return taken;
+}
+
+inline void SimpleSegregatedStorage::memory_pool_free_n(void *first,
+                                                        void *last) {
+  next_of(last) = free_memory;
+  free_memory = first;
+}
+
+inline void SimpleSegregatedStorage::ordered_free(void *chunk) {
+  void *const loc = find_prev(chunk);
+  if (loc == nullptr) {
+    memory_pool_free(chunk);
+  } else {
+    next_of(chunk) = next_of(loc);
+    next_of(loc) = chunk;
+  }
+}
+
+inline void *
+SimpleSegregatedStorage::try_malloc_n(void *&start, std::size_t n,
+                                      const std::size_t &partition_size) {
+  void *iter = next_of(start);
+  while (--n != 0) {
+    void *next = next_of(iter);
+    if (next != static_cast<char *>(iter) + partition_size) {
+      // end of the list, or a gap between chunks
+      start = iter;
+      return nullptr;
+    }
+    iter = next;
+  }
+  return iter;
+}
+
+inline void *SimpleSegregatedStorage::ordered_malloc_n(
+    const std::size_t &n, const std::size_t &partition_size) {
+  if (n == 0)
+    return nullptr;
+  // free_memory acts as the node before the first chunk
+  void *start = &free_memory;
+  void *last;
+  do {
+    if (next_of(start) == nullptr)
+      return nullptr;
+    last = try_malloc_n(start, n, partition_size);
+  } while (last == nullptr);
+  void *const ret = next_of(start);
+  next_of(start) = next_of(last);
+  return ret;
+}
+
+inline void *SimpleSegregatedStorage::find_prev(void *ptr) {
   if (free_memory == nullptr || std::greater_equal<>()(free_memory, ptr))
     return nullptr;
 
@@ -0,0 +1,210 @@
+/*
+ * @author: Pei Mu
+ * @description: Size-class allocator built from simple segregated storages
+ * @data: 16th Oct 2026
+ * */
+
+#ifndef SIZE_CLASS_POOL_H
+#define SIZE_CLASS_POOL_H
+
+#include "BlockTable.hpp"
+#include "SimpleSegregatedStorage.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace memory_pool {
+/*
+ * The chunk size of each size class.
+ * */
+inline constexpr std::array<std::size_t, 21> size_classes = {
+    8,   16,  32,  48,  64,  80,  96,  112, 128, 160, 192,
+    224, 256, 320, 384, 448, 512, 640, 768, 896, 1024};
+
+/*
+ * Map (size + 7) / 8 to the smallest size class holding size.
+ * */
+constexpr std::array<std::uint8_t, (1024 >> 3) + 1> make_size_class_lookup() {
+  std::array<std::uint8_t, (1024 >> 3) + 1> lookup{};
+  std::uint8_t index = 0;
+  for (std::size_t i = 0; i < lookup.size(); i++) {
+    while (size_classes[index] < (i << 3))
+      index++;
+    lookup[i] = index;
+  }
+  return lookup;
+}
+
+inline constexpr auto size_class_lookup = make_size_class_lookup();
+
+/*
+ * A table of simple segregated storages, one for each size class.
+ * Objects of different types but similar sizes share the same storage, so
+ * dozens of small types don't need dozens of half-empty pools.
+ *
+ * The size classes follow the spacing of jemalloc: 8, 16, then four classes
+ * between two powers of two, up to max_size. allocate(size) finds the class
+ * with a table lookup, and requests bigger than max_size go to malloc.
+ * A chunk is aligned to the largest power of two dividing its class size,
+ * capped by the 16 bytes alignment of malloc.
+ * */
+class SizeClassPool {
+public:
+  static constexpr std::size_t max_size = size_classes.back();
+  static constexpr std::size_t class_num = size_classes.size();
+  /*
+   * Every size class grows by a block of exactly this size, aligned to its
+   * size, so the block of a chunk is found by masking its address.
+   * */
+  static constexpr std::size_t block_size = 64 * 1024;
+
+  SizeClassPool() {
+    for (std::size_t i = 0; i < class_num; i++) {
+      classes[i].partition_size = size_classes[i];
+      classes[i].index = static_cast<std::uint8_t>(i);
+      classes[i].block_classes = &block_classes;
+    }
+  }
+
+  SizeClassPool(const SizeClassPool &) = delete;
+  SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+  ~SizeClassPool() { purge_memory(); }
+
+  void *allocate(const std::size_t &size) {
+    if (size > max_size)
+      return malloc(size);
+    return classes[class_index(size)].malloc_chunk();
+  }
+
+  /*
+   * The size must be the one given to allocate.
+   * */
+  void deallocate(void *const chunk, const std::size_t &size) {
+    if (size > max_size) {
+      free(chunk);
+      return;
+    }
+    classes[class_index(size)].free_chunk(chunk);
+  }
+
+  /*
+   * Give a chunk back without its size, e.g. when the caller stores no size
+   * header. The size class is found from the block of the chunk in O(1), and
+   * a chunk from no block is taken as a big one from malloc.
+   * */
+  void deallocate(void *const chunk) {
+    const std::size_t index = class_of(chunk);
+    if (index == class_num)
+      free(chunk);
+    else
+      classes[index].free_chunk(chunk);
+  }
+
+  /*
+   * The size class of the block holding chunk, or class_num if it is not in
+   * a block of this pool.
+   * */
+  std::size_t class_of(const void *const chunk) const {
+    auto block = reinterpret_cast<std::uintptr_t>(chunk) & ~(block_size - 1);
+    auto iter = block_classes.find(block);
+    return iter == block_classes.end() ? class_num : iter->second;
+  }
+
+  /*
+   * Check if chunk is in a block of this pool. The big chunks from malloc
+   * are not.
+   * */
+  bool owns(const void *const chunk) const {
+    return class_of(chunk) != class_num;
+  }
+
+  /*
+   * The size class serving the requested size, in O(1).
+   * */
+  static std::size_t class_index(const std::size_t &size) {
+    return size_class_lookup[(size + 7) >> 3];
+  }
+
+  /*
+   * The real size of the chunks of a size class.
+   * */
+  static std::size_t class_size(const std::size_t &index) {
+    return size_classes[index];
+  }
+
+  /*
+   * The guaranteed alignment of the chunks of a size class.
+   * */
+  static std::size_t class_alignment(const std::size_t &index) {
+    const std::size_t size = size_classes[index];
+    return std::min(size & -size, alignof(std::max_align_t));
+  }
+
+  /*
+   * Release all blocks of all size classes.
+   * */
+  void purge_memory() {
+    for (auto &size_class : classes)
+      size_class.purge_memory();
+    block_classes.clear();
+  }
+
+private:
+  /*
+   * The storage of one size class, growing by a lazy block at a time.
+   * */
+  class SizeClass : protected SimpleSegregatedStorage {
+  public:
+    void *malloc_chunk() {
+      if (free_memory != nullptr)
+        return memory_pool_malloc();
+      if (carvable())
+        return carve();
+      return malloc_need_resize();
+    }
+
+    void free_chunk(void *const chunk) { memory_pool_free(chunk); }
+
+    void purge_memory() {
+      for (const auto &block : memory_blocks)
+        free(block.begin);
+      memory_blocks.clear();
+      free_memory = nullptr;
+      bump_ptr = bump_end = nullptr;
+    }
+
+    std::size_t partition_size = 0;
+    std::uint8_t index = 0;
+    std::unordered_map<std::uintptr_t, std::uint8_t> *block_classes = nullptr;
+
+  private:
+    void *malloc_need_resize() {
+      void *ptr = std::aligned_alloc(block_size, block_size);
+      if (ptr == nullptr)
+        return nullptr;
+      try {
+        memory_blocks.add(ptr, block_size);
+        block_classes->emplace(reinterpret_cast<std::uintptr_t>(ptr), index);
+      } catch (...) {
+        memory_blocks.remove(ptr);
+        free(ptr);
+        return nullptr;
+      }
+      add_block_lazy(ptr, block_size, partition_size);
+      return carve();
+    }
+
+    BlockTable memory_blocks;
+  };
+
+  SizeClass classes[class_num];
+  // the size class of each block by its address
+  std::unordered_map<std::uintptr_t, std::uint8_t> block_classes;
+};
+} // namespace memory_pool
+
+#endif // SIZE_CLASS_POOL_H
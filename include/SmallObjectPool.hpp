@@ -0,0 +1,310 @@
+/*
+ * @author: Pei Mu
+ * @description: Memory pool for element types smaller than a pointer
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef SMALL_OBJECT_POOL_H
+#define SMALL_OBJECT_POOL_H
+
+#include "BlockTable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace memory_pool {
+/*
+ * A pool whose chunks are exactly sizeof(element_type), while MemoryPool
+ * rounds every chunk up to a pointer, e.g. 8 bytes for a 1-byte element.
+ *
+ * The blocks are block_size bytes, aligned to their size, and start with a
+ * small header, so the block of a chunk is found by masking its address.
+ * The free list of a block links the chunks by a 16-bit index stored in the
+ * free chunks, so elements of 2 bytes or more cost nothing but the header.
+ * A 1-byte element can't hold an index, its block keeps a bitmap of the
+ * used chunks instead, one bit per chunk.
+ * The chunks of a new block are carved in order, so its pages are not
+ * touched before they are used.
+ * */
+template <typename element_type, std::size_t block_size = 64 * 1024>
+class SmallObjectPool {
+  static_assert((block_size & (block_size - 1)) == 0,
+                "the block size must be a power of two");
+
+  typedef std::uint16_t index_type;
+  static constexpr index_type no_chunk = 0xffff;
+
+  struct Block {
+    // the next block with free chunks
+    Block *next_available;
+    std::size_t free_num;
+    // the used chunks in the bitmap mode, the carved ones otherwise
+    std::size_t used_num;
+    index_type free_head;
+  };
+
+  static constexpr std::size_t round_up(const std::size_t &size,
+                                        const std::size_t &align) {
+    return (size + align - 1) / align * align;
+  }
+
+public:
+  static constexpr std::size_t chunk_size = sizeof(element_type);
+  static constexpr bool bitmap_mode = chunk_size < sizeof(index_type);
+
+private:
+  static constexpr std::size_t bitmap_offset =
+      round_up(sizeof(Block), alignof(std::uint64_t));
+  static constexpr std::size_t max_chunk_num() {
+    const std::size_t space =
+        block_size - bitmap_offset - alignof(element_type);
+    // a bitmap word of 8 bytes for every 64 chunks
+    return bitmap_mode ? space * 8 / (chunk_size * 8 + 1) / 64 * 64
+                       : space / chunk_size;
+  }
+
+public:
+  static constexpr std::size_t chunk_num = max_chunk_num();
+  static_assert(chunk_num > 0, "the block is too small for an element");
+  static_assert(bitmap_mode || chunk_num < no_chunk,
+                "too many chunks for a 16-bit index, use a smaller block");
+
+  SmallObjectPool() = default;
+  SmallObjectPool(const SmallObjectPool &) = delete;
+  SmallObjectPool &operator=(const SmallObjectPool &) = delete;
+
+  /*
+   * Destroy the objects still alive and release all blocks.
+   * */
+  ~SmallObjectPool() { purge_memory(); }
+
+  template <typename... Args> element_type *construct(Args &&...args) {
+    void *const chunk = malloc_chunk();
+    if (chunk == nullptr)
+      return nullptr;
+    try {
+      return ::new (chunk) element_type(std::forward<Args>(args)...);
+    } catch (...) {
+      free_chunk(chunk);
+      throw;
+    }
+  }
+
+  void destroy(element_type *const chunk) {
+    chunk->~element_type();
+    free_chunk(chunk);
+  }
+
+  /*
+   * Take a chunk, return nullptr if no block can be allocated.
+   * */
+  void *malloc_chunk() {
+    if (available == nullptr && !add_block())
+      return nullptr;
+    Block *const block = available;
+    void *const chunk = take(block);
+    if (--block->free_num == 0) {
+      available = block->next_available;
+    }
+    return chunk;
+  }
+
+  void free_chunk(void *const chunk) {
+    Block *const block = block_of(chunk);
+    put(block, chunk);
+    if (block->free_num++ == 0) {
+      block->next_available = available;
+      available = block;
+    }
+  }
+
+  /*
+   * Check if chunk is in a block of this pool.
+   * */
+  bool owns(const void *const chunk) const {
+    return memory_blocks.find(chunk) != nullptr;
+  }
+
+  /*
+   * Give the fully free blocks back, return true if any block is released.
+   * */
+  bool release_memory();
+
+  /*
+   * Destroy the live objects and release all blocks.
+   * */
+  bool purge_memory();
+
+  std::size_t get_block_num() const { return memory_blocks.size(); }
+
+private:
+  static Block *block_of(const void *const chunk) {
+    return reinterpret_cast<Block *>(reinterpret_cast<std::uintptr_t>(chunk) &
+                                     ~(block_size - 1));
+  }
+
+  static std::uint64_t *bitmap(Block *const block) {
+    return reinterpret_cast<std::uint64_t *>(reinterpret_cast<char *>(block) +
+                                             bitmap_offset);
+  }
+
+  static char *chunks(Block *const block) {
+    constexpr std::size_t bitmap_size =
+        bitmap_mode ? chunk_num / 64 * sizeof(std::uint64_t) : 0;
+    constexpr std::size_t offset =
+        round_up(bitmap_offset + bitmap_size, alignof(element_type));
+    return reinterpret_cast<char *>(block) + offset;
+  }
+
+  static std::size_t index_of(Block *const block, const void *const chunk) {
+    return static_cast<std::size_t>(static_cast<const char *>(chunk) -
+                                    chunks(block)) /
+           chunk_size;
+  }
+
+  /*
+   * The free list index stored in a free chunk, which may be unaligned.
+   * */
+  static index_type next_of(const void *const chunk) {
+    index_type next;
+    memcpy(&next, chunk, sizeof(next));
+    return next;
+  }
+
+  static void *take(Block *const block);
+  static void put(Block *const block, void *const chunk);
+  static bool is_free(Block *const block, const std::size_t &index);
+
+  bool add_block();
+
+  // the blocks with free chunks
+  Block *available = nullptr;
+  BlockTable memory_blocks;
+};
+
+template <typename element_type, std::size_t block_size>
+void *SmallObjectPool<element_type, block_size>::take(Block *const block) {
+  if constexpr (bitmap_mode) {
+    // the used chunks are dense in the low words, so start from there
+    std::uint64_t *const words = bitmap(block);
+    std::size_t word = block->used_num / 64;
+    while (words[word] == ~std::uint64_t(0))
+      word = word + 1 == chunk_num / 64 ? 0 : word + 1;
+    const std::size_t bit = __builtin_ctzll(~words[word]);
+    words[word] |= std::uint64_t(1) << bit;
+    block->used_num++;
+    return chunks(block) + (word * 64 + bit) * chunk_size;
+  } else {
+    if (block->free_head != no_chunk) {
+      char *const chunk = chunks(block) + block->free_head * chunk_size;
+      block->free_head = next_of(chunk);
+      return chunk;
+    }
+    return chunks(block) + block->used_num++ * chunk_size;
+  }
+}
+
+template <typename element_type, std::size_t block_size>
+void SmallObjectPool<element_type, block_size>::put(Block *const block,
+                                                    void *const chunk) {
+  const std::size_t index = index_of(block, chunk);
+  if constexpr (bitmap_mode) {
+    bitmap(block)[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    block->used_num--;
+  } else {
+    memcpy(chunk, &block->free_head, sizeof(index_type));
+    block->free_head = static_cast<index_type>(index);
+  }
+}
+
+template <typename element_type, std::size_t block_size>
+bool SmallObjectPool<element_type, block_size>::is_free(
+    Block *const block, const std::size_t &index) {
+  return !(bitmap(block)[index / 64] >> (index % 64) & 1);
+}
+
+template <typename element_type, std::size_t block_size>
+bool SmallObjectPool<element_type, block_size>::add_block() {
+  void *const ptr = std::aligned_alloc(block_size, block_size);
+  if (ptr == nullptr)
+    return false;
+  try {
+    memory_blocks.add(ptr, block_size);
+  } catch (...) {
+    free(ptr);
+    return false;
+  }
+  Block *const block = ::new (ptr) Block{available, chunk_num, 0, no_chunk};
+  if constexpr (bitmap_mode)
+    memset(bitmap(block), 0, chunk_num / 8);
+  available = block;
+  return true;
+}
+
+template <typename element_type, std::size_t block_size>
+bool SmallObjectPool<element_type, block_size>::release_memory() {
+  std::vector<void *> released;
+  for (const auto &descriptor : memory_blocks) {
+    if (reinterpret_cast<Block *>(descriptor.begin)->free_num == chunk_num)
+      released.push_back(descriptor.begin);
+  }
+  if (released.empty())
+    return false;
+
+  // rebuild the available list without the released blocks
+  Block **tail = &available;
+  for (Block *block = available; block != nullptr;
+       block = block->next_available) {
+    if (block->free_num != chunk_num) {
+      *tail = block;
+      tail = &block->next_available;
+    }
+  }
+  *tail = nullptr;
+  for (void *block : released) {
+    memory_blocks.remove(block);
+    free(block);
+  }
+  return true;
+}
+
+template <typename element_type, std::size_t block_size>
+bool SmallObjectPool<element_type, block_size>::purge_memory() {
+  if (memory_blocks.empty())
+    return false;
+  for (const auto &descriptor : memory_blocks) {
+    Block *const block = reinterpret_cast<Block *>(descriptor.begin);
+    if constexpr (!std::is_trivially_destructible_v<element_type>) {
+      if constexpr (!bitmap_mode) {
+        // mark the free chunks first, every other carved chunk is alive
+        std::vector<bool> free_chunks(block->used_num);
+        for (index_type i = block->free_head; i != no_chunk;
+             i = next_of(chunks(block) + i * chunk_size))
+          free_chunks[i] = true;
+        for (std::size_t i = 0; i < block->used_num; i++) {
+          if (!free_chunks[i])
+            reinterpret_cast<element_type *>(chunks(block) + i * chunk_size)
+                ->~element_type();
+        }
+      } else {
+        for (std::size_t i = 0; i < chunk_num; i++) {
+          if (!is_free(block, i))
+            reinterpret_cast<element_type *>(chunks(block) + i * chunk_size)
+                ->~element_type();
+        }
+      }
+    }
+    free(descriptor.begin);
+  }
+  memory_blocks.clear();
+  available = nullptr;
+  return true;
+}
+} // namespace memory_pool
+
+#endif // SMALL_OBJECT_POOL_H
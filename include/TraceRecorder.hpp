@@ -0,0 +1,216 @@
+/*
+ * @author: Pei Mu
+ * @description: Allocation trace recorder of the memory pool
+ * @data: 17th Oct 2026
+ * */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace memory_pool {
+enum class TraceOp : std::uint8_t { construct = 0, destroy = 1 };
+
+/*
+ * One record of the binary trace, 24 bytes.
+ * The object is the address of its chunk, which is reused after the object is
+ * destroyed, so a destroy refers to the last construct at the same address.
+ * The size is the chunk size of the pool.
+ * The sequence numbers the events of all pools and threads, the records are
+ * written per buffer, so their order in the file is not the event order.
+ * */
+struct TraceRecord {
+  TraceOp op;
+  std::uint8_t reserved;
+  std::uint16_t thread;
+  std::uint32_t size;
+  std::uint64_t object;
+  std::uint64_t sequence;
+};
+static_assert(sizeof(TraceRecord) == 24, "the trace record must be packed");
+
+/*
+ * The trace file starts with the magic and the version, the records follow
+ * in the byte order of the recording machine.
+ * */
+constexpr char trace_magic[8] = {'M', 'P', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr std::uint32_t trace_version = 2;
+
+/*
+ * A statistics policy writing every construct/destroy of the pool to the
+ * trace file opened by start(), e.g.
+ *  MemoryPool<Foo, MallocBlockProvider, TraceRecorder> pool;
+ *  TraceRecorder::start("foo.trace");
+ * The records are buffered in the pool and written with one fwrite per
+ * buffer_records, so the pool can be recorded in production. When no trace
+ * is started, every event costs one relaxed load.
+ * Like the pool, a recorder is not thread safe, but the pools of all threads
+ * can write to the same trace.
+ * */
+class TraceRecorder {
+public:
+  static constexpr std::size_t buffer_records = 4096;
+
+  TraceRecorder() = default;
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+  ~TraceRecorder() { flush(); }
+
+  /*
+   * Open the trace file and write its header, return false if it cannot be
+   * opened. The previous trace is stopped.
+   * */
+  static bool start(const char *path) {
+    std::lock_guard<std::mutex> guard(sink_lock());
+    close_sink();
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr)
+      return false;
+    fwrite(trace_magic, sizeof(trace_magic), 1, file);
+    fwrite(&trace_version, sizeof(trace_version), 1, file);
+    trace_generation().fetch_add(1, std::memory_order_relaxed);
+    sink().store(file, std::memory_order_release);
+    return true;
+  }
+
+  /*
+   * Close the trace file. The records still buffered in the live pools are
+   * dropped, pool.get_stats().flush() them before to keep them.
+   * */
+  static void stop() {
+    std::lock_guard<std::mutex> guard(sink_lock());
+    close_sink();
+  }
+
+  static bool recording() {
+    return sink().load(std::memory_order_relaxed) != nullptr;
+  }
+
+  /*
+   * Write the buffered records to the trace. The buffer is not a state of the
+   * pool, so it can be flushed through get_stats().
+   * */
+  void flush() const {
+    if (records.empty())
+      return;
+    std::lock_guard<std::mutex> guard(sink_lock());
+    FILE *file = sink().load(std::memory_order_relaxed);
+    if (file != nullptr &&
+        generation == trace_generation().load(std::memory_order_relaxed))
+      fwrite(records.data(), sizeof(TraceRecord), records.size(), file);
+    records.clear();
+  }
+
+  void init(const std::size_t &chunk_size_val) {
+    chunk_size = static_cast<std::uint32_t>(chunk_size_val);
+  }
+  void on_malloc(const std::size_t &) {}
+  void on_free(const std::size_t &) {}
+  void on_resize(const std::size_t &, const std::size_t &) {}
+  void on_release(const std::size_t &, const std::size_t &) {}
+  void on_purge() {}
+
+  void on_construct(const void *chunk) { record(TraceOp::construct, chunk); }
+  void on_destroy(const void *chunk) { record(TraceOp::destroy, chunk); }
+
+private:
+  void record(const TraceOp &op, const void *chunk) {
+    if (!recording())
+      return;
+    // drop the records of a stopped trace
+    const std::uint32_t current =
+        trace_generation().load(std::memory_order_relaxed);
+    if (generation != current) {
+      records.clear();
+      generation = current;
+    }
+    if (records.capacity() == 0)
+      records.reserve(buffer_records);
+    records.push_back({op, 0, thread_id(), chunk_size,
+                       reinterpret_cast<std::uintptr_t>(chunk),
+                       sequence().fetch_add(1, std::memory_order_relaxed)});
+    if (records.size() == buffer_records)
+      flush();
+  }
+
+  /*
+   * A small number per thread, in the order the threads record first.
+   * */
+  static std::uint16_t thread_id() {
+    static std::atomic<std::uint16_t> thread_num{0};
+    thread_local const std::uint16_t id =
+        thread_num.fetch_add(1, std::memory_order_relaxed);
+    return id;
+  }
+
+  static std::atomic<std::uint64_t> &sequence() {
+    static std::atomic<std::uint64_t> counter{0};
+    return counter;
+  }
+
+  static std::atomic<FILE *> &sink() {
+    static std::atomic<FILE *> file{nullptr};
+    return file;
+  }
+
+  /*
+   * Counts the started traces.
+   * */
+  static std::atomic<std::uint32_t> &trace_generation() {
+    static std::atomic<std::uint32_t> generation{0};
+    return generation;
+  }
+
+  static std::mutex &sink_lock() {
+    static std::mutex lock;
+    return lock;
+  }
+
+  static void close_sink() {
+    if (FILE *file = sink().exchange(nullptr))
+      fclose(file);
+  }
+
+  std::uint32_t chunk_size = 0;
+  std::uint32_t generation = 0;
+  mutable std::vector<TraceRecord> records;
+};
+
+/*
+ * Read all records of a trace file in the event order, return false if it is
+ * not a trace of this version.
+ * */
+inline bool read_trace(const char *path, std::vector<TraceRecord> &records) {
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return false;
+  char magic[sizeof(trace_magic)];
+  std::uint32_t version = 0;
+  bool valid = fread(magic, sizeof(magic), 1, file) == 1 &&
+               memcmp(magic, trace_magic, sizeof(magic)) == 0 &&
+               fread(&version, sizeof(version), 1, file) == 1 &&
+               version == trace_version;
+  if (valid) {
+    TraceRecord buffer[TraceRecorder::buffer_records];
+    std::size_t n;
+    while ((n = fread(buffer, sizeof(TraceRecord),
+                      TraceRecorder::buffer_records, file)) > 0)
+      records.insert(records.end(), buffer, buffer + n);
+    std::stable_sort(records.begin(), records.end(),
+                     [](const TraceRecord &lhs, const TraceRecord &rhs) {
+                       return lhs.sequence < rhs.sequence;
+                     });
+  }
+  fclose(file);
+  return valid;
+}
+} // namespace memory_pool
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,58 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the out-of-line block table
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include "BlockTable.hpp"
+
+TEST(BlockTableTest, TestAddRemove) {
+	memory_pool::BlockTable table;
+	EXPECT_TRUE(table.empty());
+	char memory[4096];
+	table.add(memory + 2048, 1024);
+	table.add(memory, 1024);
+	table.add(memory + 1024, 512);
+	EXPECT_EQ(table.size(), 3);
+
+	// allocation order
+	EXPECT_EQ(table[0].begin, memory + 2048);
+	EXPECT_EQ(table[1].begin, memory);
+	EXPECT_EQ(table.back().begin, memory + 1024);
+	// address order
+	EXPECT_EQ(table.sorted()[0].begin, memory);
+	EXPECT_EQ(table.sorted()[1].begin, memory + 1024);
+	EXPECT_EQ(table.sorted()[2].begin, memory + 2048);
+
+	table.remove(memory);
+	EXPECT_EQ(table.size(), 2);
+	EXPECT_EQ(table[0].begin, memory + 2048);
+	EXPECT_EQ(table[1].begin, memory + 1024);
+	EXPECT_EQ(table.sorted()[0].begin, memory + 1024);
+	// not a block
+	table.remove(memory + 1);
+	EXPECT_EQ(table.size(), 2);
+
+	table.clear();
+	EXPECT_TRUE(table.empty());
+	EXPECT_TRUE(table.sorted().empty());
+}
+
+TEST(BlockTableTest, TestFind) {
+	memory_pool::BlockTable table;
+	char memory[4096];
+	EXPECT_EQ(table.find(memory), nullptr);
+	table.add(memory + 1024, 1024);
+	table.add(memory + 3072, 512);
+
+	EXPECT_EQ(table.find(memory), nullptr);
+	EXPECT_EQ(table.find(memory + 1023), nullptr);
+	EXPECT_EQ(table.find(memory + 1024)->begin, memory + 1024);
+	EXPECT_EQ(table.find(memory + 2047)->begin, memory + 1024);
+	// the gap between the blocks
+	EXPECT_EQ(table.find(memory + 2048), nullptr);
+	EXPECT_EQ(table.find(memory + 3072)->begin, memory + 3072);
+	EXPECT_EQ(table.find(memory + 3583)->size, 512);
+	EXPECT_EQ(table.find(memory + 3584), nullptr);
+}
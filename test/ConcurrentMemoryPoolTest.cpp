@@ -0,0 +1,185 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the concurrent memory pool
+ * @data: 16th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "ConcurrentMemoryPool.hpp"
+
+#define THREAD_NUM 8
+#define OBJECT_NUM 1000
+
+struct Point {
+	int x, y, z;
+};
+
+TEST(ConcurrentMemoryPoolTest, TestSingleThread) {
+	auto mp = memory_pool::ConcurrentMemoryPool<Point>(100, 1000);
+	auto first_chunk = mp.construct();
+	ASSERT_NE(first_chunk, nullptr);
+	first_chunk->x = 1;
+	auto second_chunk = mp.construct();
+	EXPECT_NE(first_chunk, second_chunk);
+	EXPECT_EQ(first_chunk->x, 1);
+
+	// the freed chunk is served again from the magazine of this thread
+	mp.destroy(first_chunk);
+	auto third_chunk = mp.construct();
+	EXPECT_EQ(third_chunk, first_chunk);
+
+	mp.destroy(second_chunk);
+	mp.destroy(third_chunk);
+}
+
+TEST(ConcurrentMemoryPoolTest, TestCrossThreadDestroy) {
+	auto mp = memory_pool::ConcurrentMemoryPool<std::size_t>();
+	std::vector<std::size_t *> chunks;
+	for (std::size_t i = 0; i < OBJECT_NUM; i++) {
+		chunks.emplace_back(mp.construct());
+		*chunks.back() = i;
+	}
+
+	// release all the chunks from another thread
+	std::thread consumer([&]() {
+		for (std::size_t i = 0; i < OBJECT_NUM; i++) {
+			EXPECT_EQ(*chunks[i], i);
+			mp.destroy(chunks[i]);
+		}
+	});
+	consumer.join();
+
+	// the chunks of the exited thread are reused,
+	// except the ones left in the loaded magazine of this thread
+	std::set<std::size_t *> freed(chunks.begin(), chunks.end());
+	std::set<std::size_t *> reused;
+	for (std::size_t i = 0; i < OBJECT_NUM; i++) {
+		auto chunk = mp.construct();
+		EXPECT_TRUE(reused.insert(chunk).second);
+		if (freed.count(chunk))
+			freed.erase(chunk);
+	}
+	EXPECT_LE(freed.size(), memory_pool::Magazine::capacity);
+}
+
+TEST(ConcurrentMemoryPoolTest, TestMultiThread) {
+	auto mp = memory_pool::ConcurrentMemoryPool<Point>();
+	std::vector<std::vector<Point *>> chunks(THREAD_NUM);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREAD_NUM; t++) {
+		threads.emplace_back([&, t]() {
+			for (int round = 0; round < 10; round++) {
+				for (int i = 0; i < OBJECT_NUM; i++) {
+					auto chunk = mp.construct();
+					*chunk = Point{t, round, i};
+					chunks[t].emplace_back(chunk);
+				}
+				// keep the chunks of the last round alive
+				if (round == 9)
+					break;
+				for (auto chunk : chunks[t]) {
+					EXPECT_EQ(chunk->x, t);
+					EXPECT_EQ(chunk->y, round);
+					mp.destroy(chunk);
+				}
+				chunks[t].clear();
+			}
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	// no chunk is handed out twice
+	std::set<Point *> live;
+	for (int t = 0; t < THREAD_NUM; t++) {
+		for (int i = 0; i < OBJECT_NUM; i++) {
+			auto chunk = chunks[t][i];
+			EXPECT_TRUE(live.insert(chunk).second);
+			EXPECT_EQ(chunk->x, t);
+			EXPECT_EQ(chunk->z, i);
+			mp.destroy(chunk);
+		}
+	}
+}
+
+TEST(ConcurrentMemoryPoolTest, TestPoolReleasedFirst) {
+	auto mp = new memory_pool::ConcurrentMemoryPool<Point>();
+	std::vector<Point *> chunks;
+	for (int i = 0; i < OBJECT_NUM; i++)
+		chunks.emplace_back(mp->construct());
+	std::thread consumer([&]() {
+		for (auto chunk : chunks)
+			mp->destroy(chunk);
+	});
+	consumer.join();
+
+	// the magazines of the main thread still refer to the released pool
+	delete mp;
+	auto other = memory_pool::ConcurrentMemoryPool<Point>();
+	auto chunk = other.construct();
+	EXPECT_NE(chunk, nullptr);
+	other.destroy(chunk);
+}
+
+struct CountingBlockProvider {
+	void *allocate(const std::size_t &size) {
+		void *block = malloc(size);
+		std::lock_guard<std::mutex> guard(*lock);
+		(*sizes)[block] = size;
+		return block;
+	}
+
+	void deallocate(void *block, const std::size_t &size) {
+		std::lock_guard<std::mutex> guard(*lock);
+		EXPECT_EQ((*sizes)[block], size);
+		sizes->erase(block);
+		free(block);
+	}
+
+	std::map<void *, std::size_t> *sizes;
+	std::mutex *lock;
+};
+
+TEST(ConcurrentMemoryPoolTest, TestPoolReleasedBeforeThreadExits) {
+	std::map<void *, std::size_t> sizes;
+	std::mutex sizes_lock;
+	auto mp = new memory_pool::ConcurrentMemoryPool<Point, CountingBlockProvider>(
+		100, 0, CountingBlockProvider{&sizes, &sizes_lock});
+
+	std::mutex lock;
+	std::condition_variable cv;
+	bool used = false, released = false;
+	// the worker keeps magazines of the pool, and outlives it
+	std::thread worker([&]() {
+		std::vector<Point *> chunks;
+		for (int i = 0; i < OBJECT_NUM; i++)
+			chunks.emplace_back(mp->construct());
+		for (auto chunk : chunks)
+			mp->destroy(chunk);
+		std::unique_lock<std::mutex> guard(lock);
+		used = true;
+		cv.notify_all();
+		cv.wait(guard, [&]() { return released; });
+	});
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		cv.wait(guard, [&]() { return used; });
+	}
+	EXPECT_FALSE(sizes.empty());
+
+	// the blocks are back while the worker is still alive
+	delete mp;
+	EXPECT_TRUE(sizes.empty());
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		released = true;
+	}
+	cv.notify_all();
+	worker.join();
+}
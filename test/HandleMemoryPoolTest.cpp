@@ -0,0 +1,130 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the memory pool with 32-bit handles
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include "HandleMemoryPool.hpp"
+#include <set>
+
+#define CHUNK_NUM 32
+
+struct Point {
+	Point(int x_val, int y_val, int z_val) : x(x_val), y(y_val), z(z_val) {}
+
+	int x, y, z;
+};
+
+typedef memory_pool::HandleMemoryPool<Point> PointPool;
+
+TEST(HandleMemoryPoolTest, TestHandle) {
+	EXPECT_EQ(sizeof(PointPool::handle_type), 4);
+	PointPool mp(CHUNK_NUM);
+	std::vector<PointPool::handle_type> handles;
+	for (int i = 0; i < CHUNK_NUM * 3; i++)
+		handles.emplace_back(mp.construct(i, i + 1, i + 2));
+	std::set<PointPool::handle_type> unique(handles.begin(), handles.end());
+	EXPECT_EQ(unique.size(), handles.size());
+	EXPECT_EQ(unique.count(PointPool::null_handle), 0);
+	for (int i = 0; i < CHUNK_NUM * 3; i++) {
+		Point *point = mp.resolve(handles[i]);
+		ASSERT_NE(point, nullptr);
+		EXPECT_EQ(point->x, i);
+		EXPECT_EQ(point->z, i + 2);
+	}
+	EXPECT_EQ(mp.resolve(PointPool::null_handle), nullptr);
+	for (auto handle : handles)
+		EXPECT_TRUE(mp.destroy(handle));
+}
+
+TEST(HandleMemoryPoolTest, TestStaleHandle) {
+	PointPool mp(CHUNK_NUM);
+	auto first = mp.construct(1, 2, 3);
+	EXPECT_TRUE(mp.destroy(first));
+	EXPECT_EQ(mp.resolve(first), nullptr);
+	EXPECT_FALSE(mp.destroy(first));
+
+	// the same chunk with another generation
+	auto second = mp.construct(4, 5, 6);
+	EXPECT_NE(second, first);
+	EXPECT_EQ(mp.resolve(first), nullptr);
+	EXPECT_EQ(mp.resolve(second)->x, 4);
+	EXPECT_FALSE(mp.destroy(first));
+	EXPECT_TRUE(mp.destroy(second));
+
+	// the generation 0 is skipped when it wraps
+	for (int i = 0; i < 600; i++) {
+		auto handle = mp.construct(i, i, i);
+		EXPECT_NE(handle >> 24, 0);
+		EXPECT_TRUE(mp.destroy(handle));
+	}
+}
+
+TEST(HandleMemoryPoolTest, TestReleasedBlock) {
+	PointPool mp(CHUNK_NUM);
+	std::vector<PointPool::handle_type> handles;
+	for (int i = 0; i < CHUNK_NUM * 3; i++)
+		handles.emplace_back(mp.construct(i, i, i));
+	for (int i = CHUNK_NUM; i < CHUNK_NUM * 3; i++)
+		EXPECT_TRUE(mp.destroy(handles[i]));
+	EXPECT_TRUE(mp.release_memory());
+	for (int i = CHUNK_NUM; i < CHUNK_NUM * 3; i++)
+		EXPECT_EQ(mp.resolve(handles[i]), nullptr);
+
+	// the released block number is reused, the old handles stay stale
+	std::vector<PointPool::handle_type> new_handles;
+	for (int i = 0; i < CHUNK_NUM * 2; i++)
+		new_handles.emplace_back(mp.construct(i, i, i));
+	for (int i = CHUNK_NUM; i < CHUNK_NUM * 3; i++)
+		EXPECT_EQ(mp.resolve(handles[i]), nullptr);
+	for (int i = 0; i < CHUNK_NUM; i++)
+		EXPECT_EQ(mp.resolve(handles[i])->x, i);
+	for (auto handle : new_handles)
+		EXPECT_TRUE(mp.destroy(handle));
+	for (int i = 0; i < CHUNK_NUM; i++)
+		EXPECT_TRUE(mp.destroy(handles[i]));
+}
+
+TEST(HandleMemoryPoolTest, TestFullPool) {
+	// 4 blocks of at most 2^(24 - 2) chunks
+	typedef memory_pool::HandleMemoryPool<Point, 2> SmallPool;
+	EXPECT_EQ(SmallPool::max_blocks, 4);
+	EXPECT_EQ(SmallPool::max_block_chunks, 1 << 22);
+	SmallPool mp(CHUNK_NUM, CHUNK_NUM);
+	std::vector<SmallPool::handle_type> handles;
+	SmallPool::handle_type handle;
+	while ((handle = mp.construct(1, 2, 3)) != SmallPool::null_handle)
+		handles.emplace_back(handle);
+	// the blocks do not grow beyond max_chunks
+	EXPECT_EQ(handles.size(), 4 * CHUNK_NUM);
+	EXPECT_TRUE(mp.destroy(handles.back()));
+	handles.pop_back();
+	EXPECT_NE(mp.construct(1, 2, 3), SmallPool::null_handle);
+}
+
+struct alignas(64) Line {
+	explicit Line(int value_val) : value(value_val) {}
+
+	int value;
+};
+
+TEST(HandleMemoryPoolTest, TestAlignedProvider) {
+	// the inner pool sees the alignment of the blocks, and doesn't pad them
+	typedef memory_pool::HandleBlockProvider<memory_pool::MmapBlockProvider> Provider;
+	EXPECT_EQ(memory_pool::block_alignment_of<Provider>::value,
+	          memory_pool::MmapBlockProvider::block_alignment);
+
+	memory_pool::HandleMemoryPool<Line, 8, memory_pool::MmapBlockProvider> mp(CHUNK_NUM);
+	std::vector<std::uint32_t> handles;
+	for (int i = 0; i < CHUNK_NUM * 3; i++)
+		handles.emplace_back(mp.construct(i));
+	for (int i = 0; i < CHUNK_NUM * 3; i++) {
+		Line *line = mp.resolve(handles[i]);
+		ASSERT_NE(line, nullptr);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(line) % 64, 0);
+		EXPECT_EQ(line->value, i);
+	}
+	for (auto handle : handles)
+		EXPECT_TRUE(mp.destroy(handle));
+}
@@ -0,0 +1,122 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the lock-free segregated storage and memory pool
+ * @data: 16th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include "LockFreeMemoryPool.hpp"
+
+#define BLOCK_SIZE 1000
+#define PARTITION_SIZE 40
+#define THREAD_NUM 8
+#define OBJECT_NUM 1000
+
+class AtomicSegregatedStorageTester :
+	public memory_pool::AtomicSegregatedStorage {
+ public:
+	void test_free_chain(void *first, void *last) {
+		memory_pool_free_chain(first, last);
+	}
+
+	void *test_malloc() {
+		return memory_pool_malloc();
+	}
+
+	void test_free(void *trunk) {
+		memory_pool_free(trunk);
+	}
+
+	bool test_empty() {
+		return empty();
+	}
+};
+
+struct Point {
+	int x, y, z;
+};
+
+TEST(AtomicSegregatedStorageTest, TestMallocFree) {
+	auto sss = AtomicSegregatedStorageTester();
+	const std::size_t block_size = BLOCK_SIZE;
+	const std::size_t partition_size = PARTITION_SIZE;
+	EXPECT_TRUE(sss.test_empty());
+	EXPECT_EQ(sss.test_malloc(), nullptr);
+
+	// push a segregated block at once
+	auto block = malloc(block_size);
+	auto last_trunk = static_cast<char *>(block) +
+		(block_size / partition_size - 1) * partition_size;
+	sss.test_free_chain(
+		memory_pool::SimpleSegregatedStorage::segregate(block, block_size, partition_size),
+		last_trunk);
+
+	// chunks are handed out in address order
+	auto first_trunk = sss.test_malloc();
+	EXPECT_EQ(first_trunk, block);
+	auto second_trunk = sss.test_malloc();
+	EXPECT_EQ(second_trunk, static_cast<char *>(block) + partition_size);
+
+	// the freed chunk is on the top of the stack
+	sss.test_free(first_trunk);
+	EXPECT_EQ(sss.test_malloc(), first_trunk);
+
+	// drain the block
+	for (std::size_t i = 2; i < block_size / partition_size; i++)
+		EXPECT_EQ(sss.test_malloc(), static_cast<char *>(block) + partition_size * i);
+	EXPECT_TRUE(sss.test_empty());
+	EXPECT_EQ(sss.test_malloc(), nullptr);
+	free(block);
+}
+
+TEST(LockFreeMemoryPoolTest, TestSingleThread) {
+	auto mp = memory_pool::LockFreeMemoryPool<Point>();
+	auto first_chunk = mp.construct();
+	ASSERT_NE(first_chunk, nullptr);
+	auto second_chunk = mp.construct();
+	EXPECT_NE(first_chunk, second_chunk);
+
+	mp.destroy(first_chunk);
+	EXPECT_EQ(mp.construct(), first_chunk);
+	mp.destroy(first_chunk);
+	mp.destroy(second_chunk);
+}
+
+TEST(LockFreeMemoryPoolTest, TestMultiThread) {
+	auto mp = memory_pool::LockFreeMemoryPool<Point>();
+	std::vector<std::vector<Point *>> chunks(THREAD_NUM);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREAD_NUM; t++) {
+		threads.emplace_back([&, t]() {
+			// free in a different order to mix the free list between threads
+			for (int round = 0; round < 100; round++) {
+				for (int i = 0; i < OBJECT_NUM / 10; i++) {
+					auto chunk = mp.construct();
+					*chunk = Point{t, round, i};
+					chunks[t].emplace_back(chunk);
+				}
+				for (std::size_t i = round % 2; i < chunks[t].size(); i += 2) {
+					EXPECT_EQ(chunks[t][i]->x, t);
+					mp.destroy(chunks[t][i]);
+					chunks[t][i] = nullptr;
+				}
+				chunks[t].erase(std::remove(chunks[t].begin(), chunks[t].end(), nullptr),
+				                chunks[t].end());
+			}
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	// no chunk is handed out twice
+	std::set<Point *> live;
+	for (int t = 0; t < THREAD_NUM; t++) {
+		for (auto chunk : chunks[t]) {
+			EXPECT_TRUE(live.insert(chunk).second);
+			EXPECT_EQ(chunk->x, t);
+			mp.destroy(chunk);
+		}
+	}
+}
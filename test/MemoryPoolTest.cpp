@@ -5,6 +5,8 @@
  * */
 
 #include <gtest/gtest.h>
+#include <map>
+#include <set>
 #include "MemoryPool.hpp"
 #include "ExampleClasses.h"
 
@@ -13,12 +15,28 @@ class MemoryPoolTester :
 	public memory_pool::MemoryPool<element_type> {
  public:
 	explicit MemoryPoolTester(std::size_t chunks_num_val = 32,
-	                          std::size_t max_chunks_val = 0) :
+	                          std::size_t max_chunks_val = 0,
+	                          bool lazy_segregation_val = false) :
 		memory_pool::MemoryPool<element_type>(chunks_num_val,
-		                                      max_chunks_val) {}
+		                                      max_chunks_val,
+		                                      lazy_segregation_val) {}
+
+	/*
+	 * The begin of the newest block, or nullptr if there is no block.
+	 */
+	void *get_last_block() {
+		return this->memory_blocks.empty() ? nullptr : this->memory_blocks.back().begin;
+	}
+
+	/*
+	 * The begin of the i-th block in allocation order.
+	 */
+	void *get_block(const std::size_t &i) {
+		return this->memory_blocks[i].begin;
+	}
 
-	memory_pool::MemoryBlock get_memory_blocks() {
-		return this->memory_blocks;
+	std::size_t get_block_num() {
+		return this->memory_blocks.size();
 	}
 
 	std::size_t get_requested_size() {
@@ -40,6 +58,10 @@ class MemoryPoolTester :
 	bool test_purge_memory() {
 		return this->purge_memory();
 	}
+
+	void *get_free_memory() {
+		return this->free_memory;
+	}
 };
 
 TEST(MemoryPoolTest, TestDefaultSizeT) {
@@ -47,7 +69,7 @@ TEST(MemoryPoolTest, TestDefaultSizeT) {
 	auto mp = MemoryPoolTester<std::size_t>();
 	auto memory_chunk = mp.construct();
 	const int partition_size = sizeof(std::size_t);
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_EQ(mp.get_chunks_num(), 64);
 	// by default, the requested size is the size of data type
@@ -55,25 +77,25 @@ TEST(MemoryPoolTest, TestDefaultSizeT) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<std::size_t *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<std::size_t *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestFloat) {
@@ -81,7 +103,7 @@ TEST(MemoryPoolTest, TestFloat) {
 	auto mp = MemoryPoolTester<float>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(float), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -89,25 +111,25 @@ TEST(MemoryPoolTest, TestFloat) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<float *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<float *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestByteType) {
@@ -115,7 +137,7 @@ TEST(MemoryPoolTest, TestByteType) {
 	auto mp = MemoryPoolTester<ByteType>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(ByteType), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -123,25 +145,25 @@ TEST(MemoryPoolTest, TestByteType) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<ByteType *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<ByteType *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestPointerType) {
@@ -149,7 +171,7 @@ TEST(MemoryPoolTest, TestPointerType) {
 	auto mp = MemoryPoolTester<PointerType>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(PointerType), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -157,25 +179,25 @@ TEST(MemoryPoolTest, TestPointerType) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<PointerType *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<PointerType *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestCharArray) {
@@ -183,7 +205,7 @@ TEST(MemoryPoolTest, TestCharArray) {
 	auto mp = MemoryPoolTester<FixedStringType>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(FixedStringType), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -191,25 +213,25 @@ TEST(MemoryPoolTest, TestCharArray) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<FixedStringType *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<FixedStringType *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestStructure) {
@@ -217,7 +239,7 @@ TEST(MemoryPoolTest, TestStructure) {
 	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(Point), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -225,25 +247,25 @@ TEST(MemoryPoolTest, TestStructure) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<Point *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<Point *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestBaseClass) {
@@ -251,7 +273,7 @@ TEST(MemoryPoolTest, TestBaseClass) {
 	auto mp = MemoryPoolTester<Base1>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(Base1), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -259,25 +281,25 @@ TEST(MemoryPoolTest, TestBaseClass) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<Base1 *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<Base1 *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestDerivedClass) {
@@ -285,7 +307,7 @@ TEST(MemoryPoolTest, TestDerivedClass) {
 	auto mp = MemoryPoolTester<Derived>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
 	auto memory_chunk = mp.construct();
 	const int partition_size = std::lcm(sizeof(Derived), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
@@ -293,61 +315,657 @@ TEST(MemoryPoolTest, TestDerivedClass) {
 
 	// test malloc
 	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<Derived *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
 	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<Derived *>(address));
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
 }
 
 TEST(MemoryPoolTest, TestNodefaultConstClass) {
 	// test memory pool construction
-
-	auto test = MemoryPoolTester<NoDefaultConstructor>(...);
-
 	auto mp = MemoryPoolTester<NoDefaultConstructor>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
-	mp.allocate(2);
-	auto memory_chunk = mp.construct();
+	auto memory_chunk = mp.construct(2);
+	EXPECT_EQ(memory_chunk->GetNumber(), 2);
 	const int partition_size = std::lcm(sizeof(NoDefaultConstructor), sizeof(void *));
-	EXPECT_EQ(memory_chunk, mp.get_memory_blocks().begin());
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
 	// for the temporary chunk size, it's the double size of the chunk number
 	EXPECT_GE(mp.get_chunks_num(), g_ChunkNum);
 	// by default, the requested size is the size of data type
 	EXPECT_EQ(mp.get_requested_size(), sizeof(NoDefaultConstructor));
 
 	// test malloc
-	auto second_chunk = mp.construct();
-	// check the address of next chunk
-	EXPECT_EQ(mp.get_next_chunk(memory_chunk), second_chunk);
-	void *address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size;
+	auto second_chunk = mp.construct(3);
+	EXPECT_EQ(second_chunk->GetNumber(), 3);
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
 	EXPECT_EQ(second_chunk, static_cast<NoDefaultConstructor *>(address));
+	// check the address of next chunk
+	EXPECT_EQ(mp.get_free_memory(), static_cast<char *>(address) + partition_size);
 
 	// test free
 	mp.destroy(memory_chunk);
 	address = static_cast<void *>(second_chunk);
-	EXPECT_EQ(mp.get_memory_blocks().begin(), static_cast<char *>(address) - partition_size);
+	EXPECT_EQ(mp.get_last_block(), static_cast<char *>(address) - partition_size);
 
 	// malloc again
-	auto third_trunk = mp.construct();
-	EXPECT_EQ(third_trunk, mp.get_memory_blocks().begin());
-	address = static_cast<char *>(mp.get_memory_blocks().begin()) + partition_size*2;
-	EXPECT_EQ(mp.get_next_chunk(third_trunk), static_cast<NoDefaultConstructor *>(address));
+	auto third_trunk = mp.construct(4);
+	EXPECT_EQ(third_trunk, mp.get_last_block());
+	address = static_cast<char *>(mp.get_last_block()) + partition_size*2;
+	EXPECT_EQ(mp.get_free_memory(), address);
 
 	// test memory pool destroy
 	EXPECT_TRUE(mp.test_purge_memory());
-	EXPECT_EQ(mp.get_memory_blocks().begin(), nullptr);
+	EXPECT_EQ(mp.get_last_block(), nullptr);
+}
+
+TEST(MemoryPoolTest, TestLazySegregation) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool, true);
+	auto memory_chunk = mp.construct();
+	const int partition_size = std::lcm(sizeof(Point), sizeof(void *));
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
+	// the new block is not linked to the free list
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+
+	// the next chunk is carved from the bump pointer
+	auto second_chunk = mp.construct();
+	void *address = static_cast<char *>(mp.get_last_block()) + partition_size;
+	EXPECT_EQ(second_chunk, static_cast<Point *>(address));
+
+	// freed chunks are reused first
+	mp.destroy(memory_chunk);
+	EXPECT_EQ(mp.get_free_memory(), memory_chunk);
+	EXPECT_EQ(mp.construct(), memory_chunk);
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+
+	// use up the first block, and resize
+	auto first_block = mp.get_last_block();
+	std::vector<Point *> chunks;
+	for (std::size_t chunk_id = 2; chunk_id < g_ChunkNum; chunk_id++)
+		chunks.emplace_back(mp.construct());
+	EXPECT_EQ(mp.get_last_block(), first_block);
+	auto resized_chunk = mp.construct();
+	EXPECT_NE(mp.get_last_block(), first_block);
+	EXPECT_EQ(resized_chunk, mp.get_last_block());
+
+	EXPECT_TRUE(mp.test_purge_memory());
+	EXPECT_EQ(mp.get_last_block(), nullptr);
+}
+
+TEST(MemoryPoolTest, TestConstructDestroyN) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	const int partition_size = std::lcm(sizeof(Point), sizeof(void *));
+	std::vector<Point *> chunks(g_ChunkNum * 3);
+
+	// the first batch comes from a single block
+	EXPECT_EQ(mp.construct_n(chunks.data(), g_ChunkNum), g_ChunkNum);
+	auto first_block = mp.get_last_block();
+	for (std::size_t i = 0; i < g_ChunkNum; i++) {
+		void *address = static_cast<char *>(first_block) + partition_size * i;
+		EXPECT_EQ(chunks[i], static_cast<Point *>(address));
+	}
+
+	// the second batch needs a resize in the middle
+	EXPECT_EQ(mp.construct_n(chunks.data() + g_ChunkNum, g_ChunkNum * 2), g_ChunkNum * 2);
+	EXPECT_NE(mp.get_last_block(), first_block);
+	std::set<Point *> unique_chunks(chunks.begin(), chunks.end());
+	EXPECT_EQ(unique_chunks.size(), chunks.size());
+
+	// the destroyed batch is linked in order and spliced on the free list
+	mp.destroy_n(chunks.data(), g_ChunkNum);
+	EXPECT_EQ(mp.get_free_memory(), chunks[0]);
+	for (std::size_t i = 0; i + 1 < g_ChunkNum; i++)
+		EXPECT_EQ(mp.get_next_chunk(chunks[i]), chunks[i + 1]);
+
+	// and taken again in the same order
+	std::vector<Point *> again(g_ChunkNum);
+	EXPECT_EQ(mp.construct_n(again.data(), g_ChunkNum), g_ChunkNum);
+	for (std::size_t i = 0; i < g_ChunkNum; i++)
+		EXPECT_EQ(again[i], chunks[i]);
+
+	mp.destroy_n(again.data(), g_ChunkNum);
+	mp.destroy_n(chunks.data() + g_ChunkNum, g_ChunkNum * 2);
+	EXPECT_TRUE(mp.test_purge_memory());
+}
+
+TEST(MemoryPoolTest, TestConstructNLazy) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool, true);
+	std::vector<Point *> chunks(g_ChunkNum * 3);
+	EXPECT_EQ(mp.construct_n(chunks.data(), chunks.size()), chunks.size());
+	std::set<Point *> unique_chunks(chunks.begin(), chunks.end());
+	EXPECT_EQ(unique_chunks.size(), chunks.size());
+	mp.destroy_n(chunks.data(), chunks.size());
+	EXPECT_EQ(mp.get_free_memory(), chunks[0]);
+}
+
+TEST(MemoryPoolTest, TestConstructNNoDefault) {
+	auto mp = MemoryPoolTester<NoDefaultConstructor>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	std::vector<NoDefaultConstructor *> chunks(g_ChunkNum * 2);
+
+	// all objects are constructed with the same argument, across a resize
+	EXPECT_EQ(mp.construct_n(chunks.data(), chunks.size(), 7), chunks.size());
+	std::set<NoDefaultConstructor *> unique_chunks(chunks.begin(), chunks.end());
+	EXPECT_EQ(unique_chunks.size(), chunks.size());
+	for (auto chunk : chunks)
+		EXPECT_EQ(chunk->GetNumber(), 7);
+
+	mp.destroy_n(chunks.data(), chunks.size());
+	EXPECT_EQ(mp.get_free_memory(), chunks[0]);
+}
+
+TEST(MemoryPoolTest, TestContiguous) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	const int partition_size = std::lcm(sizeof(Point), sizeof(void *));
+
+	// the first array needs a new block
+	auto array = mp.allocate_contiguous(10);
+	EXPECT_EQ(array, mp.get_last_block());
+	void *address = reinterpret_cast<char *>(array) + partition_size * 10;
+	EXPECT_EQ(mp.get_free_memory(), address);
+
+	// single chunks come after the array
+	auto chunk = mp.construct();
+	EXPECT_EQ(chunk, static_cast<Point *>(address));
+
+	// the array is given back in order, and found again
+	mp.free_contiguous(array, 10);
+	EXPECT_EQ(mp.get_free_memory(), array);
+	EXPECT_EQ(mp.allocate_contiguous(5), array);
+	EXPECT_EQ(mp.allocate_contiguous(5), array + partition_size / sizeof(Point) * 5);
+
+	// an array bigger than the chunk number gets its own block
+	auto big_array = mp.allocate_contiguous(g_ChunkNum * 4);
+	EXPECT_EQ(big_array, mp.get_last_block());
+	mp.free_contiguous(big_array, g_ChunkNum * 4);
+	EXPECT_EQ(mp.allocate_contiguous(g_ChunkNum * 4), big_array);
+	mp.free_contiguous(big_array, g_ChunkNum * 4);
+	mp.free_contiguous(array, 10);
+	mp.ordered_destroy(chunk);
+
+	// the size of the block would wrap around
+	const std::size_t max_chunks = SIZE_MAX / partition_size;
+	EXPECT_EQ(mp.allocate_contiguous(max_chunks + 1), nullptr);
+	EXPECT_EQ(mp.allocate_contiguous(SIZE_MAX / 2 + 1), nullptr);
+}
+
+TEST(MemoryPoolTest, TestContiguousLazy) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool, true);
+	const int partition_size = std::lcm(sizeof(Point), sizeof(void *));
+	auto chunk = mp.construct();
+
+	// the array is carved from the bump pointer
+	auto array = mp.allocate_contiguous(10);
+	void *address = reinterpret_cast<char *>(chunk) + partition_size;
+	EXPECT_EQ(array, static_cast<Point *>(address));
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+	mp.free_contiguous(array, 10);
+	mp.ordered_destroy(chunk);
+	EXPECT_EQ(mp.get_free_memory(), chunk);
+	EXPECT_EQ(mp.allocate_contiguous(SIZE_MAX / partition_size + 2), nullptr);
+}
+
+TEST(MemoryPoolTest, TestMultiArgsClass) {
+	auto mp = MemoryPoolTester<TestClass>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	auto memory_chunk = mp.construct(1, 2, 3);
+	EXPECT_EQ(memory_chunk, mp.get_last_block());
+	EXPECT_EQ(memory_chunk->GetSum(), 6);
+
+	// the object is constructed once, nothing is written back to it
+	auto second_chunk = mp.construct(10, 20, 30);
+	EXPECT_EQ(memory_chunk->GetSum(), 6);
+	EXPECT_EQ(second_chunk->GetSum(), 60);
+
+	mp.destroy(memory_chunk);
+	mp.destroy(second_chunk);
+	EXPECT_EQ(mp.get_free_memory(), second_chunk);
+}
+
+class CountedClass {
+ public:
+	CountedClass() { count++; }
+	virtual ~CountedClass() { count--; }
+
+	static int count;
+};
+
+int CountedClass::count = 0;
+
+TEST(MemoryPoolTest, TestDestroyVirtualClass) {
+	{
+		auto mp = MemoryPoolTester<CountedClass>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+		std::vector<CountedClass *> chunks;
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 2; chunk_id++)
+			chunks.emplace_back(mp.construct());
+		EXPECT_EQ(CountedClass::count, g_ChunkNum * 2);
+
+		// the virtual destructor is called
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 2; chunk_id += 2)
+			mp.destroy(chunks[chunk_id]);
+		EXPECT_EQ(CountedClass::count, g_ChunkNum);
+	}
+	// the live objects are destructed once when the pool is released
+	EXPECT_EQ(CountedClass::count, 0);
+}
+
+TEST(MemoryPoolTest, TestReleaseMemory) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	EXPECT_FALSE(mp.release_memory());
+
+	// three blocks: g_ChunkNum, g_ChunkNum * 2 and g_ChunkNum * 4 chunks
+	std::vector<Point *> chunks;
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 7; chunk_id++)
+		chunks.emplace_back(mp.construct());
+	auto first_block = mp.get_block(0);
+	EXPECT_EQ(chunks[0], first_block);
+
+	// keep one object in the first block
+	for (std::size_t chunk_id = 1; chunk_id < chunks.size(); chunk_id++)
+		mp.destroy(chunks[chunk_id]);
+	EXPECT_TRUE(mp.release_memory());
+	EXPECT_EQ(mp.get_last_block(), first_block);
+	EXPECT_EQ(mp.get_block_num(), 1);
+	EXPECT_EQ(mp.get_chunks_num(), g_ChunkNum);
+
+	// the free chunks of the first block are left in address order
+	EXPECT_EQ(mp.get_free_memory(), chunks[1]);
+	EXPECT_EQ(mp.get_next_chunk(chunks[1]), chunks[2]);
+	EXPECT_EQ(mp.construct(), chunks[1]);
+	EXPECT_FALSE(mp.release_memory());
+
+	mp.destroy(chunks[1]);
+	mp.destroy(chunks[0]);
+	EXPECT_TRUE(mp.release_memory());
+	EXPECT_EQ(mp.get_block_num(), 0);
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+	EXPECT_NE(mp.construct(), nullptr);
+}
+
+TEST(MemoryPoolTest, TestReleaseMemoryLazy) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool, true);
+	auto first_chunk = mp.construct();
+	auto second_chunk = mp.construct();
+	mp.destroy(first_chunk);
+
+	// the chunks behind the bump pointer are free as well
+	EXPECT_FALSE(mp.release_memory());
+	mp.destroy(second_chunk);
+	EXPECT_TRUE(mp.release_memory());
+	EXPECT_EQ(mp.get_block_num(), 0);
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+	EXPECT_NE(mp.construct(), nullptr);
+}
+
+TEST(MemoryPoolTest, TestTrimPolicy) {
+	auto mp = MemoryPoolTester<Point>(g_ChunkNum, g_MaxNumberOfObjectsInPool);
+	memory_pool::TrimPolicy policy;
+	policy.check_interval = g_ChunkNum;
+	policy.free_fraction = 0.5;
+	policy.idle_time = std::chrono::hours(1);
+	mp.set_trim_policy(policy);
+
+	std::vector<Point *> chunks;
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 3; chunk_id++)
+		chunks.emplace_back(mp.construct());
+	mp.destroy_n(chunks.data(), chunks.size());
+	// not idle for long enough
+	EXPECT_NE(mp.get_block_num(), 0);
+
+	policy.idle_time = std::chrono::steady_clock::duration::zero();
+	mp.set_trim_policy(policy);
+	chunks.clear();
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum; chunk_id++)
+		chunks.emplace_back(mp.construct());
+	// half of the chunks are free after the first check
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum; chunk_id++)
+		mp.destroy(chunks[chunk_id]);
+	EXPECT_EQ(mp.get_block_num(), 0);
+	EXPECT_EQ(mp.get_free_memory(), nullptr);
+}
+
+TEST(MemoryPoolTest, TestPurgeUnorderedFreeList) {
+	for (bool lazy : {false, true}) {
+		auto mp = MemoryPoolTester<CountedClass>(g_ChunkNum, g_MaxNumberOfObjectsInPool, lazy);
+		std::vector<CountedClass *> chunks;
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 5; chunk_id++)
+			chunks.emplace_back(mp.construct());
+
+		// free the chunks out of address order, across the blocks
+		for (std::size_t chunk_id = 0; chunk_id < chunks.size(); chunk_id += 3)
+			mp.destroy(chunks[chunks.size() - 1 - chunk_id]);
+		std::size_t live = 0;
+		for (std::size_t chunk_id = 0; chunk_id < chunks.size(); chunk_id++) {
+			if ((chunks.size() - 1 - chunk_id) % 3 == 0)
+				continue;
+			if (chunk_id % 7 == 1)
+				mp.destroy(chunks[chunk_id]);
+			else
+				live++;
+		}
+		EXPECT_EQ(CountedClass::count, live);
+
+		// every live object is destructed exactly once
+		EXPECT_TRUE(mp.test_purge_memory());
+		EXPECT_EQ(CountedClass::count, 0);
+	}
+}
+
+/*
+ * A chunk of 64 bytes, so 64 chunks fill a page exactly.
+ */
+class CountedLine {
+ public:
+	CountedLine() { count++; }
+	~CountedLine() { count--; }
+
+	char data[64];
+	static int count;
+};
+
+int CountedLine::count = 0;
+
+TEST(MemoryPoolTest, TestPurgeFullyCarvedLazyBlock) {
+	{
+		// the mapped blocks can be adjacent, and the last one is fully carved
+		memory_pool::MemoryPool<CountedLine, memory_pool::MmapBlockProvider> mp(64, 0, true);
+		for (std::size_t chunk_id = 0; chunk_id < 64 * 3; chunk_id++)
+			mp.construct();
+		EXPECT_EQ(CountedLine::count, 64 * 3);
+	}
+	EXPECT_EQ(CountedLine::count, 0);
+}
+
+/*
+ * Check every block is given back with the size it is allocated with.
+ */
+struct CountingBlockProvider {
+	void *allocate(const std::size_t &size) {
+		void *block = malloc(size);
+		(*sizes)[block] = size;
+		return block;
+	}
+
+	void deallocate(void *block, const std::size_t &size) {
+		EXPECT_EQ((*sizes)[block], size);
+		sizes->erase(block);
+		free(block);
+	}
+
+	std::map<void *, std::size_t> *sizes;
+};
+
+TEST(MemoryPoolTest, TestBlockProvider) {
+	std::map<void *, std::size_t> sizes;
+	{
+		memory_pool::MemoryPool<Point, CountingBlockProvider> mp(
+			g_ChunkNum, g_MaxNumberOfObjectsInPool, false, CountingBlockProvider{&sizes});
+		std::vector<Point *> chunks;
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 3; chunk_id++)
+			chunks.emplace_back(mp.construct());
+		EXPECT_EQ(sizes.size(), 2);
+		for (std::size_t chunk_id = g_ChunkNum; chunk_id < g_ChunkNum * 3; chunk_id++)
+			mp.destroy(chunks[chunk_id]);
+		EXPECT_TRUE(mp.release_memory());
+		EXPECT_EQ(sizes.size(), 1);
+	}
+	EXPECT_TRUE(sizes.empty());
+}
+
+TEST(MemoryPoolTest, TestMmapBlockProvider) {
+	using memory_pool::MmapBlockProvider;
+	for (unsigned flags : {unsigned(MmapBlockProvider::none),
+	                       unsigned(MmapBlockProvider::populate),
+	                       unsigned(MmapBlockProvider::transparent_huge | MmapBlockProvider::populate),
+	                       unsigned(MmapBlockProvider::huge_tlb)}) {
+		memory_pool::MemoryPool<Point, MmapBlockProvider> mp(
+			g_ChunkNum, 0, false, MmapBlockProvider(flags));
+		std::vector<Point *> chunks;
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 7; chunk_id++) {
+			chunks.emplace_back(mp.construct(Point{1, 2, 3}));
+			EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunks.back()) % alignof(Point), 0);
+		}
+		for (auto chunk : chunks)
+			EXPECT_EQ(chunk->z, 3);
+		mp.destroy_n(chunks.data(), chunks.size());
+		EXPECT_TRUE(mp.release_memory());
+	}
+}
+
+/*
+ * The chunk numbers of the blocks in the provider, in increasing order.
+ */
+std::vector<std::size_t> block_chunk_nums(const std::map<void *, std::size_t> &sizes,
+                                          const std::size_t &partition_size) {
+	std::vector<std::size_t> chunk_nums;
+	for (auto &block : sizes)
+		chunk_nums.emplace_back(block.second / partition_size);
+	std::sort(chunk_nums.begin(), chunk_nums.end());
+	return chunk_nums;
+}
+
+template <typename growth_policy>
+std::vector<std::size_t> grow_three_blocks(const std::size_t &max_chunks) {
+	std::map<void *, std::size_t> sizes;
+	memory_pool::MemoryPool<Point, CountingBlockProvider, memory_pool::NoStats,
+	                        growth_policy> mp(g_ChunkNum, max_chunks, false,
+	                                          CountingBlockProvider{&sizes});
+	std::vector<Point *> chunks;
+	while (sizes.size() < 3)
+		chunks.emplace_back(mp.construct());
+	auto chunk_nums = block_chunk_nums(sizes, std::lcm(sizeof(Point), sizeof(void *)));
+	mp.destroy_n(chunks.data(), chunks.size());
+	return chunk_nums;
+}
+
+TEST(MemoryPoolTest, TestGrowthPolicy) {
+	using memory_pool::GeometricGrowth;
+	using memory_pool::LinearGrowth;
+	EXPECT_EQ(grow_three_blocks<GeometricGrowth<>>(0),
+	          std::vector<std::size_t>({g_ChunkNum, g_ChunkNum * 2, g_ChunkNum * 4}));
+	EXPECT_EQ((grow_three_blocks<GeometricGrowth<3, 2>>(0)),
+	          std::vector<std::size_t>({g_ChunkNum, g_ChunkNum * 3 / 2, g_ChunkNum * 9 / 4}));
+	EXPECT_EQ(grow_three_blocks<LinearGrowth<16>>(0),
+	          std::vector<std::size_t>({g_ChunkNum, g_ChunkNum + 16, g_ChunkNum + 32}));
+	// the growth is capped by max_chunks, in chunks of element_type
+	EXPECT_EQ(grow_three_blocks<GeometricGrowth<>>(g_ChunkNum * 3),
+	          std::vector<std::size_t>({g_ChunkNum, g_ChunkNum * 3 / 2, g_ChunkNum * 3 / 2}));
+
+	// a factor close to 1 still grows by one chunk
+	GeometricGrowth<11, 10> slow;
+	EXPECT_EQ(slow.next_chunk_num(1), 2);
+	EXPECT_EQ(slow.next_chunk_num(100), 110);
+}
+
+/*
+ * A clock only moved by the test, so the rates seen by AdaptiveGrowth don't
+ * depend on the speed of the machine.
+ */
+struct FakeClock {
+	typedef std::chrono::microseconds duration;
+	typedef duration::rep rep;
+	typedef duration::period period;
+	typedef std::chrono::time_point<FakeClock> time_point;
+	static constexpr bool is_steady = true;
+
+	static time_point now() {
+		return time_point(elapsed);
+	}
+
+	static duration elapsed;
+};
+
+FakeClock::duration FakeClock::elapsed{0};
+
+TEST(MemoryPoolTest, TestAdaptiveGrowth) {
+	memory_pool::AdaptiveGrowth<10000, 4, FakeClock> growth;
+	// no rate is known for the first block
+	EXPECT_EQ(growth.next_chunk_num(100), 200);
+	// a burst: the last block is used up at once
+	FakeClock::elapsed += std::chrono::microseconds(100);
+	EXPECT_EQ(growth.next_chunk_num(200), 800);
+	// a steady growth: the last block lasts the horizon
+	FakeClock::elapsed += std::chrono::milliseconds(10);
+	EXPECT_EQ(growth.next_chunk_num(800), 200);
+	// a slow growth: the last block lasts much longer than the horizon
+	FakeClock::elapsed += std::chrono::milliseconds(100);
+	EXPECT_EQ(growth.next_chunk_num(200), 80);
+
+	// the chunks of the pool always follow the policy
+	auto chunk_nums =
+		grow_three_blocks<memory_pool::AdaptiveGrowth<10000, 4, FakeClock>>(0);
+	EXPECT_EQ(chunk_nums[0], g_ChunkNum);
+	EXPECT_EQ(chunk_nums[1], g_ChunkNum * 2);
+	EXPECT_EQ(chunk_nums[2], g_ChunkNum * 8);
+}
+
+TEST(MemoryPoolTest, TestReserve) {
+	std::map<void *, std::size_t> sizes;
+	const std::size_t partition_size = std::lcm(sizeof(Point), sizeof(void *));
+	for (bool lazy : {false, true}) {
+		memory_pool::MemoryPool<Point, CountingBlockProvider> mp(
+			g_ChunkNum, 0, lazy, CountingBlockProvider{&sizes});
+		EXPECT_TRUE(mp.reserve(0));
+		EXPECT_TRUE(sizes.empty());
+
+		// one block of exactly the reserved chunks
+		EXPECT_TRUE(mp.reserve(g_ChunkNum * 5));
+		EXPECT_EQ(block_chunk_nums(sizes, partition_size),
+		          std::vector<std::size_t>({g_ChunkNum * 5}));
+		std::vector<Point *> chunks;
+		for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 5 - 10; chunk_id++)
+			chunks.emplace_back(mp.construct(Point{1, 2, 3}));
+		EXPECT_EQ(sizes.size(), 1);
+
+		// only the missing chunks are allocated
+		EXPECT_TRUE(mp.reserve(10));
+		EXPECT_EQ(sizes.size(), 1);
+		EXPECT_TRUE(mp.reserve(15));
+		EXPECT_EQ(block_chunk_nums(sizes, partition_size),
+		          std::vector<std::size_t>({5, g_ChunkNum * 5}));
+		for (std::size_t chunk_id = 0; chunk_id < 15; chunk_id++)
+			chunks.emplace_back(mp.construct(Point{1, 2, 3}));
+		EXPECT_EQ(sizes.size(), 2);
+
+		// the reserved block does not change the growth of the next block
+		chunks.emplace_back(mp.construct(Point{1, 2, 3}));
+		EXPECT_EQ(block_chunk_nums(sizes, partition_size),
+		          std::vector<std::size_t>({5, g_ChunkNum, g_ChunkNum * 5}));
+		std::set<Point *> unique(chunks.begin(), chunks.end());
+		EXPECT_EQ(unique.size(), chunks.size());
+		mp.destroy_n(chunks.data(), chunks.size());
+		EXPECT_FALSE(mp.reserve(std::numeric_limits<std::size_t>::max()));
+	}
+	EXPECT_TRUE(sizes.empty());
+}
+
+TEST(MemoryPoolTest, TestExactBlockSize) {
+	// no metadata at the tail, 512 pages make exactly 2 MiB
+	typedef char Page[4096];
+	std::map<void *, std::size_t> sizes;
+	{
+		memory_pool::MemoryPool<Page, CountingBlockProvider> mp(
+			512, 512, false, CountingBlockProvider{&sizes});
+		std::vector<Page *> pages;
+		for (int i = 0; i < 1024; i++)
+			pages.emplace_back(mp.construct());
+		EXPECT_EQ(sizes.size(), 2);
+		for (auto &block : sizes)
+			EXPECT_EQ(block.second, 2 * 1024 * 1024);
+		mp.destroy_n(pages.data(), pages.size());
+	}
+	EXPECT_TRUE(sizes.empty());
+}
+
+TEST(MemoryPoolTest, TestOwns) {
+	memory_pool::MemoryPool<Point> mp(g_ChunkNum);
+	memory_pool::MemoryPool<Point> other_mp(g_ChunkNum);
+	std::vector<Point *> chunks;
+	// several blocks
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 4; chunk_id++)
+		chunks.emplace_back(mp.construct(Point{1, 2, 3}));
+	Point *other = other_mp.construct(Point{1, 2, 3});
+	Point local{1, 2, 3};
+
+	for (auto chunk : chunks) {
+		EXPECT_TRUE(mp.owns(chunk));
+		EXPECT_FALSE(other_mp.owns(chunk));
+	}
+	EXPECT_FALSE(mp.owns(other));
+	EXPECT_TRUE(other_mp.owns(other));
+	EXPECT_FALSE(mp.owns(&local));
+	EXPECT_FALSE(mp.owns(nullptr));
+	// an interior pointer of a chunk is not a chunk
+	EXPECT_FALSE(mp.owns(&chunks.front()->y));
+
+	for (auto chunk : chunks)
+		mp.destroy(chunk);
+	other_mp.destroy(other);
+	mp.release_memory();
+	EXPECT_FALSE(mp.owns(chunks.front()));
+}
+
+struct alignas(64) CacheLineType {
+	int value;
+};
+
+template <typename pool_type>
+void check_alignment(pool_type &mp, const std::size_t &alignment) {
+	std::vector<int *> chunks;
+	// several blocks
+	for (std::size_t chunk_id = 0; chunk_id < g_ChunkNum * 4; chunk_id++) {
+		int *chunk = reinterpret_cast<int *>(mp.construct());
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunk) % alignment, 0);
+		*chunk = static_cast<int>(chunk_id);
+		chunks.emplace_back(chunk);
+	}
+	for (std::size_t chunk_id = 0; chunk_id < chunks.size(); chunk_id++)
+		EXPECT_EQ(*chunks[chunk_id], static_cast<int>(chunk_id));
+	for (std::size_t chunk_id = 0; chunk_id < chunks.size(); chunk_id += 2)
+		mp.ordered_destroy(reinterpret_cast<decltype(mp.construct())>(chunks[chunk_id]));
+	EXPECT_FALSE(mp.release_memory());
+	for (std::size_t chunk_id = 1; chunk_id < chunks.size(); chunk_id += 2)
+		mp.ordered_destroy(reinterpret_cast<decltype(mp.construct())>(chunks[chunk_id]));
+	EXPECT_TRUE(mp.release_memory());
+}
+
+TEST(MemoryPoolTest, TestAlignment) {
+	// an over-aligned type
+	memory_pool::MemoryPool<CacheLineType> mp(g_ChunkNum);
+	check_alignment(mp, 64);
+
+	// an int padded to a cache line
+	memory_pool::MemoryPool<int, memory_pool::MallocBlockProvider,
+	                        memory_pool::NoStats, memory_pool::GeometricGrowth<>, 64>
+		padded_mp(g_ChunkNum);
+	check_alignment(padded_mp, 64);
+	int *first = padded_mp.construct(1);
+	int *second = padded_mp.construct(2);
+	EXPECT_EQ(reinterpret_cast<char *>(second) - reinterpret_cast<char *>(first), 64);
+	padded_mp.destroy(first);
+	padded_mp.destroy(second);
+
+	// the blocks are over-allocated only if the provider aligns them less
+	std::map<void *, std::size_t> sizes;
+	memory_pool::MemoryPool<int, CountingBlockProvider, memory_pool::NoStats,
+	                        memory_pool::GeometricGrowth<>, 4096>
+		page_mp(g_ChunkNum, 0, false, CountingBlockProvider{&sizes});
+	check_alignment(page_mp, 4096);
+	page_mp.destroy(page_mp.construct(1));
+	EXPECT_EQ(sizes.begin()->second, g_ChunkNum * 4096 + 4096 - alignof(std::max_align_t));
+	memory_pool::MemoryPool<int, memory_pool::MmapBlockProvider,
+	                        memory_pool::NoStats, memory_pool::GeometricGrowth<>, 4096>
+		mmap_mp(g_ChunkNum);
+	check_alignment(mmap_mp, 4096);
 }
@@ -0,0 +1,113 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the monotonic arena
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <set>
+#include "MonotonicArena.hpp"
+
+#define CHUNK_NUM 32
+
+struct Point {
+	int x, y, z;
+};
+
+class CountedObject {
+ public:
+	explicit CountedObject(int value_val) : value(value_val) { count++; }
+	~CountedObject() { count--; }
+
+	int value;
+	static int count;
+};
+
+int CountedObject::count = 0;
+
+TEST(MonotonicArenaTest, TestBumpPointer) {
+	auto arena = memory_pool::MonotonicArena<Point>(CHUNK_NUM);
+	auto first_chunk = arena.construct(Point{1, 2, 3});
+	auto second_chunk = arena.construct(Point{4, 5, 6});
+	EXPECT_EQ(second_chunk, first_chunk + 1);
+	EXPECT_EQ(first_chunk->z, 3);
+	EXPECT_EQ(second_chunk->z, 6);
+
+	// the memory is reused from the beginning after reset
+	arena.reset();
+	EXPECT_EQ(arena.construct(), first_chunk);
+	EXPECT_EQ(arena.construct(), second_chunk);
+}
+
+TEST(MonotonicArenaTest, TestReuseBlocks) {
+	auto arena = memory_pool::MonotonicArena<Point>(CHUNK_NUM);
+	std::vector<Point *> chunks;
+	// three blocks: CHUNK_NUM, CHUNK_NUM * 2 and CHUNK_NUM * 4 chunks
+	for (int i = 0; i < CHUNK_NUM * 5; i++)
+		chunks.emplace_back(arena.construct(Point{i, i, i}));
+	std::set<Point *> live(chunks.begin(), chunks.end());
+	EXPECT_EQ(live.size(), chunks.size());
+	for (int i = 0; i < CHUNK_NUM * 5; i++)
+		EXPECT_EQ(chunks[i]->x, i);
+
+	// the same blocks are handed out in the same order
+	for (int round = 0; round < 3; round++) {
+		arena.reset();
+		for (int i = 0; i < CHUNK_NUM * 5; i++)
+			EXPECT_EQ(arena.construct(), chunks[i]);
+	}
+}
+
+TEST(MonotonicArenaTest, TestDestruct) {
+	{
+		auto arena = memory_pool::MonotonicArena<CountedObject>(CHUNK_NUM);
+		for (int i = 0; i < CHUNK_NUM * 3 + 1; i++)
+			arena.construct(i);
+		EXPECT_EQ(CountedObject::count, CHUNK_NUM * 3 + 1);
+		arena.reset();
+		EXPECT_EQ(CountedObject::count, 0);
+		// nothing is destructed twice
+		arena.reset();
+		EXPECT_EQ(CountedObject::count, 0);
+
+		for (int i = 0; i < CHUNK_NUM; i++)
+			EXPECT_EQ(arena.construct(i)->value, i);
+		EXPECT_EQ(CountedObject::count, CHUNK_NUM);
+	}
+	EXPECT_EQ(CountedObject::count, 0);
+}
+
+TEST(MonotonicArenaTest, TestSmallType) {
+	auto arena = memory_pool::MonotonicArena<char[3]>(CHUNK_NUM);
+	std::vector<char *> chunks;
+	for (int i = 0; i < CHUNK_NUM * 3; i++) {
+		chunks.emplace_back(*arena.construct());
+		chunks.back()[2] = static_cast<char>(i);
+	}
+	EXPECT_EQ(chunks[1], chunks[0] + 3);
+	for (int i = 0; i < CHUNK_NUM * 3; i++)
+		EXPECT_EQ(chunks[i][2], static_cast<char>(i));
+}
+
+/*
+ * Remember the size of the last block asked for, and hand out nothing.
+ */
+struct RefusingBlockProvider {
+	void *allocate(const std::size_t &size) {
+		*last_size = size;
+		return nullptr;
+	}
+
+	void deallocate(void *, const std::size_t &) {}
+
+	std::size_t *last_size;
+};
+
+TEST(MonotonicArenaTest, TestHugeChunkNum) {
+	std::size_t last_size = 0;
+	memory_pool::MonotonicArena<Point, RefusingBlockProvider> arena(
+		SIZE_MAX, RefusingBlockProvider{&last_size});
+	// the block size is capped instead of wrapping around to a small block
+	EXPECT_EQ(arena.construct(), nullptr);
+	EXPECT_GT(last_size, SIZE_MAX - sizeof(Point) * 2);
+}
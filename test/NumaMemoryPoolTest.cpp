@@ -0,0 +1,120 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the NUMA-aware memory pool with simulated nodes
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include "NumaMemoryPool.hpp"
+
+#define NODE_NUM 2
+#define OBJECT_NUM 1000
+
+/*
+ * Every thread tells which node it runs on.
+ */
+struct FakeNodeLocator {
+	unsigned node_num() const {
+		return NODE_NUM;
+	}
+
+	unsigned current_node() const {
+		return node;
+	}
+
+	static thread_local unsigned node;
+};
+
+thread_local unsigned FakeNodeLocator::node = 0;
+
+struct Point {
+	int x, y, z;
+};
+
+typedef memory_pool::NumaMemoryPool<Point, FakeNodeLocator> NumaPool;
+
+TEST(NumaMemoryPoolTest, TestCpuNodeLocator) {
+	memory_pool::CpuNodeLocator locator;
+	EXPECT_GE(locator.node_num(), 1);
+	EXPECT_LT(locator.current_node(), locator.node_num());
+
+	auto mp = memory_pool::NumaMemoryPool<Point>();
+	EXPECT_EQ(mp.node_num(), locator.node_num());
+	auto chunk = mp.construct(Point{1, 2, 3});
+	EXPECT_EQ(chunk->z, 3);
+	EXPECT_LT(mp.node_of(chunk), mp.node_num());
+	mp.destroy(chunk);
+}
+
+TEST(NumaMemoryPoolTest, TestNodeLocal) {
+	NumaPool mp;
+	FakeNodeLocator::node = 0;
+	auto first_chunk = mp.construct();
+	FakeNodeLocator::node = 1;
+	auto second_chunk = mp.construct();
+	EXPECT_EQ(mp.node_of(first_chunk), 0);
+	EXPECT_EQ(mp.node_of(second_chunk), 1);
+
+	// freed on node 1, but the chunk goes back to node 0
+	mp.destroy(first_chunk);
+	EXPECT_NE(mp.construct(), first_chunk);
+	FakeNodeLocator::node = 0;
+	EXPECT_EQ(mp.construct(), first_chunk);
+}
+
+TEST(NumaMemoryPoolTest, TestMultiThread) {
+	NumaPool mp(32);
+	std::vector<std::vector<Point *>> chunks(NODE_NUM * 2);
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < chunks.size(); t++) {
+		threads.emplace_back([&, t]() {
+			FakeNodeLocator::node = t % NODE_NUM;
+			for (int i = 0; i < OBJECT_NUM; i++)
+				chunks[t].emplace_back(mp.construct(Point{static_cast<int>(t), i, 0}));
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+	threads.clear();
+
+	// every thread frees the chunks of a thread on the other node
+	for (unsigned t = 0; t < chunks.size(); t++) {
+		threads.emplace_back([&, t]() {
+			FakeNodeLocator::node = t % NODE_NUM;
+			for (auto chunk : chunks[(t + 1) % chunks.size()]) {
+				EXPECT_EQ(mp.node_of(chunk), (t + 1) % NODE_NUM);
+				mp.destroy(chunk);
+			}
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+
+	// the chunks are reused by their own node only
+	FakeNodeLocator::node = 1;
+	std::set<unsigned> nodes;
+	for (int i = 0; i < OBJECT_NUM; i++) {
+		auto chunk = mp.construct();
+		nodes.insert(mp.node_of(chunk));
+		mp.destroy(chunk);
+	}
+	EXPECT_EQ(nodes, std::set<unsigned>{1});
+}
+
+TEST(NumaMemoryPoolTest, TestForeignChunk) {
+	NumaPool mp;
+	Point local;
+	EXPECT_THROW(mp.node_of(&local), std::invalid_argument);
+	EXPECT_THROW(mp.destroy(&local), std::invalid_argument);
+}
+
+TEST(NumaMemoryPoolTest, TestPopulate) {
+	NumaPool mp(1024, 0, FakeNodeLocator(), memory_pool::MmapBlockProvider::populate);
+	FakeNodeLocator::node = 1;
+	auto chunk = mp.construct(Point{1, 2, 3});
+	EXPECT_EQ(mp.node_of(chunk), 1);
+	EXPECT_EQ(chunk->y, 2);
+	mp.destroy(chunk);
+}
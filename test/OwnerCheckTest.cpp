@@ -0,0 +1,77 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the foreign free check of memory pool
+ * @data: 17th Oct 2026
+ * */
+
+/*
+ * The whole test is built with MEMORY_POOL_CHECK_OWNER (see CMakeLists.txt).
+ * */
+#ifndef MEMORY_POOL_CHECK_OWNER
+#error "the owner check test needs MEMORY_POOL_CHECK_OWNER"
+#endif
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+// all headers, like OwnerCheckUnit.cpp
+#include "ConcurrentMemoryPool.hpp"
+#include "HandleMemoryPool.hpp"
+#include "LockFreeMemoryPool.hpp"
+#include "MemoryPool.hpp"
+#include "MonotonicArena.hpp"
+#include "NumaMemoryPool.hpp"
+#include "PoolAllocator.hpp"
+#include "PoolMemoryResource.hpp"
+#include "PoolPtr.hpp"
+#include "SizeClassPool.hpp"
+#include "SmallObjectPool.hpp"
+#include "TraceRecorder.hpp"
+#include "ExampleClasses.h"
+
+#define CHUNK_NUM 32
+
+// defined in OwnerCheckUnit.cpp
+bool rejects_foreign_chunk();
+
+TEST(OwnerCheckTest, TestForeignDestroy) {
+	memory_pool::MemoryPool<Point> mp(CHUNK_NUM);
+	memory_pool::MemoryPool<Point> other_mp(CHUNK_NUM);
+	Point *chunk = mp.construct(Point{1, 2, 3});
+	Point *other = other_mp.construct(Point{4, 5, 6});
+	Point local{7, 8, 9};
+
+	EXPECT_THROW(mp.destroy(other), std::invalid_argument);
+	EXPECT_THROW(mp.ordered_destroy(other), std::invalid_argument);
+	EXPECT_THROW(mp.destroy(&local), std::invalid_argument);
+	EXPECT_THROW(mp.free_contiguous(other, 1), std::invalid_argument);
+	EXPECT_EQ(other->x, 4);
+
+	// nothing is destroyed by a rejected batch
+	Point *chunks[] = {chunk, other};
+	EXPECT_THROW(mp.destroy_n(chunks, 2), std::invalid_argument);
+	EXPECT_EQ(chunk->x, 1);
+
+	// both pools still work
+	EXPECT_NO_THROW(mp.destroy(chunk));
+	EXPECT_NO_THROW(other_mp.destroy(other));
+	std::vector<Point *> points;
+	for (std::size_t chunk_id = 0; chunk_id < CHUNK_NUM * 2; chunk_id++)
+		points.emplace_back(mp.construct(Point{1, 2, 3}));
+	EXPECT_NO_THROW(mp.destroy_n(points.data(), points.size()));
+}
+
+TEST(OwnerCheckTest, TestForeignFreeChunk) {
+	memory_pool::RawMemoryPool<Point> mp(CHUNK_NUM);
+	memory_pool::RawMemoryPool<Point> other_mp(CHUNK_NUM);
+	void *chunk = mp.malloc_chunk();
+	void *other = other_mp.malloc_chunk();
+	EXPECT_THROW(mp.free_chunk(other), std::invalid_argument);
+	EXPECT_NO_THROW(mp.free_chunk(chunk));
+	EXPECT_NO_THROW(other_mp.free_chunk(other));
+	EXPECT_EQ(mp.malloc_chunk(), chunk);
+}
+
+TEST(OwnerCheckTest, TestSecondUnit) {
+	EXPECT_TRUE(rejects_foreign_chunk());
+}
@@ -0,0 +1,42 @@
+/*
+ * @author: Pei Mu
+ * @description: Second translation unit of the owner check test
+ * @data: 17th Oct 2026
+ * */
+
+/*
+ * The headers are included by two translation units of the same program, so
+ * the test only links if they have no duplicate definitions, and both units
+ * see the same MEMORY_POOL_CHECK_OWNER.
+ * */
+#ifndef MEMORY_POOL_CHECK_OWNER
+#error "the owner check test needs MEMORY_POOL_CHECK_OWNER"
+#endif
+
+#include <stdexcept>
+#include "ConcurrentMemoryPool.hpp"
+#include "HandleMemoryPool.hpp"
+#include "LockFreeMemoryPool.hpp"
+#include "MemoryPool.hpp"
+#include "MonotonicArena.hpp"
+#include "NumaMemoryPool.hpp"
+#include "PoolAllocator.hpp"
+#include "PoolMemoryResource.hpp"
+#include "PoolPtr.hpp"
+#include "SizeClassPool.hpp"
+#include "SmallObjectPool.hpp"
+#include "TraceRecorder.hpp"
+#include "ExampleClasses.h"
+
+bool rejects_foreign_chunk() {
+	memory_pool::MemoryPool<Point> mp;
+	memory_pool::MemoryPool<Point> other_mp;
+	Point *other = other_mp.construct(Point{1, 2, 3});
+	try {
+		mp.destroy(other);
+	} catch (const std::invalid_argument &) {
+		other_mp.destroy(other);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,96 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the STL-compatible pool allocator
+ * @data: 16th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <list>
+#include <map>
+#include <set>
+#include <thread>
+#include <vector>
+#include "PoolAllocator.hpp"
+
+#define THREAD_NUM 8
+#define OBJECT_NUM 1000
+
+struct Point {
+	int x, y, z;
+};
+
+struct Triple {
+	float a, b, c;
+};
+
+TEST(PoolAllocatorTest, TestRebind) {
+	typedef memory_pool::PoolAllocator<int> allocator_type;
+	typedef std::allocator_traits<allocator_type>::rebind_alloc<Point> rebound_type;
+	EXPECT_TRUE((std::is_same<rebound_type, memory_pool::PoolAllocator<Point>>::value));
+
+	allocator_type allocator;
+	rebound_type rebound(allocator);
+	EXPECT_TRUE(allocator == rebound);
+	EXPECT_FALSE(allocator != rebound);
+}
+
+TEST(PoolAllocatorTest, TestSharedPool) {
+	memory_pool::PoolAllocator<Point, memory_pool::NullMutex> point_allocator;
+	memory_pool::PoolAllocator<Triple, memory_pool::NullMutex> triple_allocator;
+
+	// types of the same size and alignment share the pool
+	auto point = point_allocator.allocate(1);
+	point_allocator.deallocate(point, 1);
+	auto triple = triple_allocator.allocate(1);
+	EXPECT_EQ(static_cast<void *>(triple), static_cast<void *>(point));
+	triple_allocator.deallocate(triple, 1);
+
+	// arrays are not pooled
+	auto points = point_allocator.allocate(4);
+	points[3] = Point{1, 2, 3};
+	point_allocator.deallocate(points, 4);
+}
+
+TEST(PoolAllocatorTest, TestContainers) {
+	std::list<Point, memory_pool::PoolAllocator<Point>> list;
+	std::map<int, int, std::less<>,
+	         memory_pool::PoolAllocator<std::pair<const int, int>>> map;
+	std::set<int, std::less<>, memory_pool::PoolAllocator<int>> set;
+	for (int i = 0; i < 10000; i++) {
+		list.push_back(Point{i, i, i});
+		map[i] = i * 2;
+		set.insert(i);
+	}
+	for (int i = 0; i < 10000; i += 2) {
+		map.erase(i);
+		set.erase(i);
+	}
+	list.pop_front();
+	EXPECT_EQ(list.front().x, 1);
+	EXPECT_EQ(map.size(), 5000);
+	EXPECT_EQ(map[9999], 19998);
+	EXPECT_EQ(set.count(9998), 0);
+	EXPECT_EQ(set.count(9999), 1);
+
+	auto copy = map;
+	EXPECT_EQ(copy, map);
+}
+
+TEST(PoolAllocatorTest, TestMultiThread) {
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREAD_NUM; t++) {
+		threads.emplace_back([t]() {
+			std::list<Point, memory_pool::PoolAllocator<Point>> list;
+			for (int round = 0; round < 10; round++) {
+				for (int i = 0; i < OBJECT_NUM; i++)
+					list.push_back(Point{t, round, i});
+				for (int i = 0; i < OBJECT_NUM / 2; i++)
+					list.pop_front();
+			}
+			for (auto &point : list)
+				EXPECT_EQ(point.x, t);
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+}
@@ -0,0 +1,102 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the std::pmr memory resource
+ * @data: 16th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include "PoolMemoryResource.hpp"
+
+/*
+ * Count the requests reaching the upstream resource.
+ * */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+	std::size_t allocate_num = 0;
+	std::size_t deallocate_num = 0;
+
+ protected:
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+		allocate_num++;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+		deallocate_num++;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+		return this == &other;
+	}
+};
+
+TEST(PoolMemoryResourceTest, TestAllocateDeallocate) {
+	CountingResource upstream;
+	memory_pool::PoolMemoryResource resource(&upstream);
+	EXPECT_EQ(resource.upstream_resource(), &upstream);
+
+	auto first_chunk = resource.allocate(24, 8);
+	auto second_chunk = resource.allocate(24, 8);
+	EXPECT_NE(first_chunk, second_chunk);
+	resource.deallocate(first_chunk, 24, 8);
+	EXPECT_EQ(resource.allocate(32, 16), first_chunk);
+	resource.deallocate(first_chunk, 32, 16);
+	resource.deallocate(second_chunk, 24, 8);
+	EXPECT_EQ(upstream.allocate_num, 0);
+
+	EXPECT_TRUE(resource.is_equal(resource));
+	memory_pool::PoolMemoryResource other(&upstream);
+	EXPECT_FALSE(resource.is_equal(other));
+}
+
+TEST(PoolMemoryResourceTest, TestUpstream) {
+	CountingResource upstream;
+	memory_pool::PoolMemoryResource resource(&upstream);
+
+	// oversized
+	auto large_chunk = resource.allocate(memory_pool::SizeClassPool::max_size + 1, 8);
+	EXPECT_EQ(upstream.allocate_num, 1);
+	resource.deallocate(large_chunk, memory_pool::SizeClassPool::max_size + 1, 8);
+	EXPECT_EQ(upstream.deallocate_num, 1);
+
+	// over-aligned
+	auto aligned_chunk = resource.allocate(64, 64);
+	EXPECT_EQ(upstream.allocate_num, 2);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned_chunk) % 64, 0);
+	resource.deallocate(aligned_chunk, 64, 64);
+	EXPECT_EQ(upstream.deallocate_num, 2);
+}
+
+TEST(PoolMemoryResourceTest, TestContainers) {
+	CountingResource upstream;
+	memory_pool::PoolMemoryResource resource(&upstream);
+	{
+		std::pmr::list<int> list(&resource);
+		std::pmr::map<int, int> map(&resource);
+		for (int i = 0; i < 10000; i++) {
+			list.push_back(i);
+			map[i] = i * 2;
+		}
+		// the nodes don't reach the upstream
+		EXPECT_EQ(upstream.allocate_num, 0);
+		for (int i = 0; i < 10000; i += 2)
+			map.erase(i);
+		EXPECT_EQ(map.size(), 5000);
+		EXPECT_EQ(map[9999], 19998);
+		EXPECT_EQ(list.back(), 9999);
+	}
+	{
+		// the bucket array is big, but the nodes are still pooled
+		std::pmr::unordered_map<int, int> map(&resource);
+		for (int i = 0; i < 10000; i++)
+			map[i] = i;
+		EXPECT_EQ(map.size(), 10000);
+		EXPECT_LT(upstream.allocate_num, 100);
+	}
+	EXPECT_EQ(upstream.allocate_num, upstream.deallocate_num);
+}
@@ -0,0 +1,136 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the smart pointers to the pooled objects
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "PoolPtr.hpp"
+
+#define CHUNK_NUM 32
+
+/*
+ * Counts its live objects, to check the smart pointers destroy them.
+ */
+struct Tracked {
+	static int live;
+	int value;
+
+	explicit Tracked(int value_val) : value(value_val) {
+		if (value < 0)
+			throw std::invalid_argument("negative value");
+		live++;
+	}
+	~Tracked() { live--; }
+};
+
+int Tracked::live = 0;
+
+/*
+ * A mutex counting the pool operations, one lock per allocate or deallocate.
+ */
+struct CountingMutex {
+	static int locks;
+	void lock() { locks++; }
+	void unlock() {}
+};
+
+int CountingMutex::locks = 0;
+
+/*
+ * A provider out of memory.
+ */
+struct NullBlockProvider {
+	void *allocate(const std::size_t &) { return nullptr; }
+	void deallocate(void *, const std::size_t &) {}
+};
+
+TEST(PoolPtrTest, TestPoolUniquePtr) {
+	memory_pool::MemoryPool<Tracked> mp(CHUNK_NUM);
+	EXPECT_EQ(sizeof(memory_pool::pool_unique_ptr<Tracked>), 2 * sizeof(void *));
+	{
+		auto first = memory_pool::make_pool_unique<Tracked>(mp, 1);
+		auto second = memory_pool::make_pool_unique<Tracked>(mp, 2);
+		EXPECT_EQ(first->value, 1);
+		EXPECT_EQ(second.get_deleter().get_pool(), &mp);
+		EXPECT_EQ(Tracked::live, 2);
+
+		// the chunk goes back to the pool
+		Tracked *chunk = first.get();
+		first.reset();
+		EXPECT_EQ(Tracked::live, 1);
+		auto third = memory_pool::make_pool_unique<Tracked>(mp, 3);
+		EXPECT_EQ(third.get(), chunk);
+
+		memory_pool::pool_unique_ptr<Tracked> moved = std::move(second);
+		EXPECT_EQ(moved->value, 2);
+		EXPECT_EQ(second, nullptr);
+	}
+	EXPECT_EQ(Tracked::live, 0);
+
+	// a throwing constructor doesn't leak the chunk
+	std::vector<memory_pool::pool_unique_ptr<Tracked>> ptrs;
+	for (int i = 0; i < CHUNK_NUM * 2; i++)
+		ptrs.emplace_back(memory_pool::make_pool_unique<Tracked>(mp, i));
+	Tracked *chunk = ptrs.back().get();
+	ptrs.pop_back();
+	EXPECT_THROW(memory_pool::make_pool_unique<Tracked>(mp, -1), std::invalid_argument);
+	EXPECT_EQ(memory_pool::make_pool_unique<Tracked>(mp, 0).get(), chunk);
+	ptrs.clear();
+	EXPECT_EQ(Tracked::live, 0);
+
+	// no block for the object
+	memory_pool::MemoryPool<Tracked, NullBlockProvider> null_mp(CHUNK_NUM);
+	EXPECT_THROW(memory_pool::make_pool_unique<Tracked>(null_mp, 0), std::bad_alloc);
+}
+
+TEST(PoolPtrTest, TestSingletonUniquePtr) {
+	typedef memory_pool::singleton_unique_ptr<Tracked, CountingMutex> ptr_type;
+	EXPECT_EQ(sizeof(ptr_type), sizeof(void *));
+	CountingMutex::locks = 0;
+	{
+		ptr_type ptr = memory_pool::make_singleton_unique<Tracked, CountingMutex>(4);
+		EXPECT_EQ(ptr->value, 4);
+		EXPECT_EQ(Tracked::live, 1);
+		EXPECT_EQ(CountingMutex::locks, 1);
+	}
+	EXPECT_EQ(Tracked::live, 0);
+	EXPECT_EQ(CountingMutex::locks, 2);
+
+	EXPECT_THROW((memory_pool::make_singleton_unique<Tracked, CountingMutex>(-1)),
+	             std::invalid_argument);
+	// the chunk is taken and given back
+	EXPECT_EQ(CountingMutex::locks, 4);
+}
+
+TEST(PoolPtrTest, TestPoolAllocateShared) {
+	CountingMutex::locks = 0;
+	std::weak_ptr<Tracked> weak;
+	{
+		// the control block and the object in a single chunk
+		auto ptr = memory_pool::pool_allocate_shared<Tracked, CountingMutex>(5);
+		EXPECT_EQ(CountingMutex::locks, 1);
+		EXPECT_EQ(ptr->value, 5);
+		EXPECT_EQ(ptr.use_count(), 1);
+		std::shared_ptr<Tracked> copy = ptr;
+		EXPECT_EQ(ptr.use_count(), 2);
+		weak = ptr;
+	}
+	// the object is destroyed, the chunk is kept by the weak_ptr
+	EXPECT_EQ(Tracked::live, 0);
+	EXPECT_TRUE(weak.expired());
+	EXPECT_EQ(CountingMutex::locks, 1);
+	weak.reset();
+	EXPECT_EQ(CountingMutex::locks, 2);
+
+	// the chunks are reused
+	std::shared_ptr<Tracked> first = memory_pool::pool_allocate_shared<Tracked>(1);
+	Tracked *address = first.get();
+	first.reset();
+	std::shared_ptr<Tracked> second = memory_pool::pool_allocate_shared<Tracked>(2);
+	EXPECT_EQ(second.get(), address);
+	EXPECT_EQ(second->value, 2);
+}
@@ -0,0 +1,84 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the memory pool statistics
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include "MemoryPool.hpp"
+
+#define CHUNK_NUM 32
+
+struct Point {
+	int x, y, z;
+};
+
+typedef memory_pool::MemoryPool<Point, memory_pool::MallocBlockProvider,
+                                memory_pool::PoolStats> StatsMemoryPool;
+
+TEST(PoolStatsTest, TestNoStats) {
+	EXPECT_TRUE(std::is_empty<memory_pool::NoStats>::value);
+	// NoStats is an empty base, it adds nothing to the pool
+	EXPECT_EQ(sizeof(memory_pool::MemoryPool<Point>) +
+	              sizeof(memory_pool::PoolStats),
+	          sizeof(StatsMemoryPool));
+}
+
+TEST(PoolStatsTest, TestCounters) {
+	StatsMemoryPool mp(CHUNK_NUM);
+	const std::size_t chunk_size = std::lcm(sizeof(Point), sizeof(void *));
+	auto &stats = mp.get_stats();
+	EXPECT_EQ(stats.live(), 0);
+	EXPECT_EQ(stats.blocks(), 0);
+	EXPECT_EQ(stats.resizes(), 0);
+	EXPECT_EQ(stats.resize_time(0), 0);
+
+	// two blocks: CHUNK_NUM and CHUNK_NUM * 2 chunks
+	std::vector<Point *> chunks;
+	for (int i = 0; i < CHUNK_NUM + 1; i++)
+		chunks.emplace_back(mp.construct());
+	EXPECT_EQ(stats.live(), CHUNK_NUM + 1);
+	EXPECT_EQ(stats.peak(), CHUNK_NUM + 1);
+	EXPECT_EQ(stats.blocks(), 2);
+	EXPECT_EQ(stats.resizes(), 2);
+	EXPECT_GE(stats.resize_time(0), stats.resize_time(1));
+	EXPECT_GT(stats.resize_time(1), 0);
+	EXPECT_EQ(stats.reserved_bytes(),
+	          CHUNK_NUM * 3 * chunk_size);
+	EXPECT_EQ(stats.used_bytes(), (CHUNK_NUM + 1) * chunk_size);
+	EXPECT_EQ(stats.free_chunks(), CHUNK_NUM * 2 - 1);
+
+	// the peak stays
+	mp.destroy(chunks.back());
+	chunks.pop_back();
+	mp.destroy_n(chunks.data(), chunks.size() / 2);
+	EXPECT_EQ(stats.live(), CHUNK_NUM - CHUNK_NUM / 2);
+	EXPECT_EQ(stats.peak(), CHUNK_NUM + 1);
+
+	// the second block is fully free
+	EXPECT_TRUE(mp.release_memory());
+	EXPECT_EQ(stats.blocks(), 1);
+	EXPECT_EQ(stats.resizes(), 2);
+	EXPECT_EQ(stats.reserved_bytes(),
+	          CHUNK_NUM * chunk_size);
+	EXPECT_EQ(stats.free_chunks(), CHUNK_NUM / 2);
+
+	auto array = mp.allocate_contiguous(4);
+	EXPECT_EQ(stats.live(), CHUNK_NUM - CHUNK_NUM / 2 + 4);
+	mp.free_contiguous(array, 4);
+	EXPECT_EQ(stats.live(), CHUNK_NUM - CHUNK_NUM / 2);
+}
+
+TEST(PoolStatsTest, TestJson) {
+	StatsMemoryPool mp(CHUNK_NUM);
+	EXPECT_EQ(mp.get_stats().to_json(),
+	          "{\"chunk_size\":24,\"live\":0,\"peak\":0,\"blocks\":0,"
+	          "\"reserved_bytes\":0,\"used_bytes\":0,\"free_chunks\":0,"
+	          "\"resizes\":0,\"resize_times_us\":[]}");
+	auto chunk = mp.construct();
+	std::string json = mp.get_stats().to_json();
+	EXPECT_NE(json.find("\"live\":1,"), std::string::npos);
+	EXPECT_NE(json.find("\"resizes\":1,"), std::string::npos);
+	EXPECT_EQ(json.find("\"resize_times_us\":[]"), std::string::npos);
+	mp.destroy(chunk);
+}
@@ -39,6 +39,42 @@ class SimpleSegregatedStorageTester :
 	void *test_get_free_memory() {
 		return free_memory;
 	}
+
+	void test_add_block_lazy(void *block,
+	                         std::size_t total_size,
+	                         std::size_t partition_size) {
+		add_block_lazy(block, total_size, partition_size);
+	}
+
+	bool test_carvable() {
+		return carvable();
+	}
+
+	void *test_carve() {
+		return carve();
+	}
+
+	std::size_t test_malloc_n(void **chunks, std::size_t n) {
+		return memory_pool_malloc_n(chunks, n);
+	}
+
+	void test_free_n(void *first, void *last) {
+		memory_pool_free_n(first, last);
+	}
+
+	void test_add_ordered_block(void *block,
+	                            std::size_t total_size,
+	                            std::size_t partition_size) {
+		add_ordered_block(block, total_size, partition_size);
+	}
+
+	void test_ordered_free(void *trunk) {
+		ordered_free(trunk);
+	}
+
+	void *test_ordered_malloc_n(std::size_t n, std::size_t partition_size) {
+		return ordered_malloc_n(n, partition_size);
+	}
 };
 
 TEST(SimpleSegregatedStorageTest, TestAddBlock) {
@@ -82,3 +118,130 @@ TEST(SimpleSegregatedStorageTest, TestMallocFree) {
 	EXPECT_EQ(third_trunk, block);
 	EXPECT_EQ(sss.test_next_chunk(third_trunk), static_cast<char *>(block) + partition_size*2);
 }
+
+TEST(SimpleSegregatedStorageTest, TestLazyBlock) {
+	auto sss = SimpleSegregatedStorageTester();
+	const std::size_t block_size = BLOCK_SIZE;
+	const std::size_t partition_size = PARTITION_SIZE;
+	auto block = malloc(block_size);
+	sss.test_add_block_lazy(block, block_size, partition_size);
+
+	// nothing is linked to the free list
+	EXPECT_EQ(sss.test_get_free_memory(), nullptr);
+	EXPECT_TRUE(sss.test_carvable());
+
+	// chunks are carved in address order
+	auto first_trunk = sss.test_carve();
+	EXPECT_EQ(first_trunk, block);
+	auto second_trunk = sss.test_carve();
+	EXPECT_EQ(second_trunk, static_cast<char *>(block) + partition_size);
+
+	// freed chunks go to the free list
+	sss.test_free(first_trunk);
+	EXPECT_EQ(sss.test_get_free_memory(), first_trunk);
+	EXPECT_EQ(sss.test_malloc(), first_trunk);
+
+	for (std::size_t chunk_num = 2; chunk_num < block_size / partition_size; chunk_num++) {
+		EXPECT_TRUE(sss.test_carvable());
+		EXPECT_EQ(sss.test_carve(), static_cast<char *>(block) + partition_size * chunk_num);
+	}
+	EXPECT_FALSE(sss.test_carvable());
+	free(block);
+}
+
+TEST(SimpleSegregatedStorageTest, TestLazyBlockLeftover) {
+	auto sss = SimpleSegregatedStorageTester();
+	const std::size_t block_size = BLOCK_SIZE;
+	const std::size_t partition_size = PARTITION_SIZE;
+	auto first_block = malloc(block_size);
+	auto second_block = malloc(block_size);
+	sss.test_add_block_lazy(first_block, block_size, partition_size);
+	EXPECT_EQ(sss.test_carve(), first_block);
+
+	// the uncarved chunks of the first block are segregated to the free list
+	sss.test_add_block_lazy(second_block, block_size, partition_size);
+	EXPECT_EQ(sss.test_get_free_memory(), static_cast<char *>(first_block) + partition_size);
+	EXPECT_EQ(sss.test_carve(), second_block);
+	free(first_block);
+	free(second_block);
+}
+
+TEST(SimpleSegregatedStorageTest, TestMallocFreeN) {
+	auto sss = SimpleSegregatedStorageTester();
+	const std::size_t block_size = BLOCK_SIZE;
+	const std::size_t partition_size = PARTITION_SIZE;
+	const std::size_t chunk_num = block_size / partition_size;
+	auto block = malloc(block_size);
+	sss.test_add_block(block, block_size, partition_size);
+
+	// take a batch of chunks in address order
+	void *chunks[chunk_num + 1];
+	EXPECT_EQ(sss.test_malloc_n(chunks, 10), 10);
+	for (std::size_t i = 0; i < 10; i++)
+		EXPECT_EQ(chunks[i], static_cast<char *>(block) + partition_size * i);
+	EXPECT_EQ(sss.test_get_free_memory(), static_cast<char *>(block) + partition_size * 10);
+
+	// splice the batch back
+	sss.test_free_n(chunks[0], chunks[9]);
+	EXPECT_EQ(sss.test_get_free_memory(), block);
+	EXPECT_EQ(sss.test_next_chunk(chunks[9]), static_cast<char *>(block) + partition_size * 10);
+
+	// there are not enough chunks
+	EXPECT_EQ(sss.test_malloc_n(chunks, chunk_num + 1), chunk_num);
+	EXPECT_EQ(sss.test_get_free_memory(), nullptr);
+	free(block);
+}
+
+TEST(SimpleSegregatedStorageTest, TestOrderedMallocFree) {
+	auto sss = SimpleSegregatedStorageTester();
+	const std::size_t block_size = BLOCK_SIZE;
+	const std::size_t partition_size = PARTITION_SIZE;
+	auto block = static_cast<char *>(malloc(block_size));
+	sss.test_add_block(block, block_size, partition_size);
+
+	// take 5 single chunks, and free 3 of them in a random order
+	void *chunks[5];
+	for (auto &chunk : chunks)
+		chunk = sss.test_malloc();
+	sss.test_ordered_free(chunks[3]);
+	sss.test_ordered_free(chunks[0]);
+	sss.test_ordered_free(chunks[1]);
+
+	// the free list is sorted by address
+	EXPECT_EQ(sss.test_get_free_memory(), chunks[0]);
+	EXPECT_EQ(sss.test_next_chunk(chunks[0]), chunks[1]);
+	EXPECT_EQ(sss.test_next_chunk(chunks[1]), chunks[3]);
+	EXPECT_EQ(sss.test_next_chunk(chunks[3]), block + partition_size * 5);
+
+	// chunk 0 and 1 are the first contiguous run
+	EXPECT_EQ(sss.test_ordered_malloc_n(2, partition_size), chunks[0]);
+	EXPECT_EQ(sss.test_get_free_memory(), chunks[3]);
+
+	// chunk 4 is still in use, so 3 chunks start from chunk 5
+	EXPECT_EQ(sss.test_ordered_malloc_n(3, partition_size), block + partition_size * 5);
+	EXPECT_EQ(sss.test_get_free_memory(), chunks[3]);
+	EXPECT_EQ(sss.test_next_chunk(chunks[3]), block + partition_size * 8);
+
+	// there are not enough chunks
+	EXPECT_EQ(sss.test_ordered_malloc_n(block_size / partition_size, partition_size), nullptr);
+	free(block);
+}
+
+TEST(SimpleSegregatedStorageTest, TestAddOrderedBlock) {
+	auto sss = SimpleSegregatedStorageTester();
+	const std::size_t partition_size = PARTITION_SIZE;
+	auto block = static_cast<char *>(malloc(partition_size * 6));
+
+	// the blocks are linked by address, not by the order they are added
+	sss.test_add_ordered_block(block + partition_size * 4, partition_size * 2, partition_size);
+	sss.test_add_ordered_block(block, partition_size * 2, partition_size);
+	sss.test_add_ordered_block(block + partition_size * 2, partition_size * 2, partition_size);
+	void *iter = sss.test_get_free_memory();
+	for (std::size_t i = 0; i < 6; i++) {
+		EXPECT_EQ(iter, block + partition_size * i);
+		iter = sss.test_next_chunk(iter);
+	}
+	EXPECT_EQ(iter, nullptr);
+	EXPECT_EQ(sss.test_ordered_malloc_n(6, partition_size), block);
+	free(block);
+}
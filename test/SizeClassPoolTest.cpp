@@ -0,0 +1,108 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the size-class pool
+ * @data: 16th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include "SizeClassPool.hpp"
+
+TEST(SizeClassPoolTest, TestClassLookup) {
+	using memory_pool::SizeClassPool;
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(0)), 8);
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(1)), 8);
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(9)), 16);
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(33)), 48);
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(129)), 160);
+	EXPECT_EQ(SizeClassPool::class_size(SizeClassPool::class_index(1024)), 1024);
+
+	// every size gets the smallest class holding it
+	for (std::size_t size = 1; size <= SizeClassPool::max_size; size++) {
+		std::size_t index = SizeClassPool::class_index(size);
+		EXPECT_GE(SizeClassPool::class_size(index), size);
+		if (index > 0) {
+			EXPECT_LT(SizeClassPool::class_size(index - 1), size);
+		}
+	}
+}
+
+TEST(SizeClassPoolTest, TestAllocateDeallocate) {
+	auto mp = memory_pool::SizeClassPool();
+	auto first_chunk = mp.allocate(24);
+	ASSERT_NE(first_chunk, nullptr);
+	auto second_chunk = mp.allocate(32);
+	EXPECT_EQ(static_cast<char *>(second_chunk), static_cast<char *>(first_chunk) + 32);
+
+	// sizes of the same class share the freed chunk
+	mp.deallocate(first_chunk, 24);
+	EXPECT_EQ(mp.allocate(17), first_chunk);
+
+	// other classes don't
+	auto third_chunk = mp.allocate(40);
+	EXPECT_NE(third_chunk, first_chunk);
+	mp.deallocate(first_chunk, 17);
+	mp.deallocate(second_chunk, 32);
+	mp.deallocate(third_chunk, 40);
+}
+
+TEST(SizeClassPoolTest, TestMixedSizes) {
+	auto mp = memory_pool::SizeClassPool();
+	std::vector<std::pair<char *, std::size_t>> chunks;
+	std::set<char *> live;
+	// more than one block per class
+	for (std::size_t i = 0; i < 20000; i++) {
+		std::size_t size = 1 + (i * 37) % memory_pool::SizeClassPool::max_size;
+		auto chunk = static_cast<char *>(mp.allocate(size));
+		ASSERT_NE(chunk, nullptr);
+		EXPECT_TRUE(live.insert(chunk).second);
+		memset(chunk, static_cast<int>(i & 0xff), size);
+		if (size % 16 == 0) {
+			EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunk) % 16, 0);
+		}
+		chunks.emplace_back(chunk, size);
+	}
+	for (std::size_t i = 0; i < chunks.size(); i++) {
+		EXPECT_EQ(static_cast<unsigned char>(chunks[i].first[chunks[i].second - 1]),
+		          i & 0xff);
+		mp.deallocate(chunks[i].first, chunks[i].second);
+	}
+}
+
+TEST(SizeClassPoolTest, TestLargeSize) {
+	auto mp = memory_pool::SizeClassPool();
+	const std::size_t size = memory_pool::SizeClassPool::max_size + 1;
+	auto chunk = static_cast<char *>(mp.allocate(size));
+	ASSERT_NE(chunk, nullptr);
+	memset(chunk, 0, size);
+	mp.deallocate(chunk, size);
+}
+
+TEST(SizeClassPoolTest, TestDeallocateWithoutSize) {
+	auto mp = memory_pool::SizeClassPool();
+	auto other_mp = memory_pool::SizeClassPool();
+	std::vector<std::pair<void *, std::size_t>> chunks;
+	for (std::size_t i = 0; i < 5000; i++) {
+		std::size_t size = 1 + (i * 37) % memory_pool::SizeClassPool::max_size;
+		chunks.emplace_back(mp.allocate(size), size);
+	}
+	for (auto &chunk : chunks) {
+		EXPECT_TRUE(mp.owns(chunk.first));
+		EXPECT_FALSE(other_mp.owns(chunk.first));
+		EXPECT_EQ(mp.class_of(chunk.first),
+		          memory_pool::SizeClassPool::class_index(chunk.second));
+	}
+	// a big chunk is not in a block, but is freed all the same
+	const std::size_t large_size = memory_pool::SizeClassPool::max_size + 1;
+	void *large_chunk = mp.allocate(large_size);
+	EXPECT_FALSE(mp.owns(large_chunk));
+	mp.deallocate(large_chunk);
+
+	// the freed chunks go back to their classes
+	for (auto &chunk : chunks)
+		mp.deallocate(chunk.first);
+	EXPECT_EQ(mp.allocate(chunks.back().second), chunks.back().first);
+	mp.deallocate(chunks.back().first);
+}
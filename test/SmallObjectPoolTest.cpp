@@ -0,0 +1,107 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the memory pool for tiny element types
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "SmallObjectPool.hpp"
+#include "ExampleClasses.h"
+
+struct Rgb {
+	std::uint8_t r, g, b;
+};
+
+/*
+ * Counts its live objects, to check the pool destroys the leftovers.
+ */
+struct Counter {
+	static int live;
+	std::uint16_t value;
+
+	explicit Counter(std::uint16_t value_val) : value(value_val) { live++; }
+	~Counter() { live--; }
+};
+
+int Counter::live = 0;
+
+template <typename element_type>
+void check_pool(const std::size_t &num) {
+	memory_pool::SmallObjectPool<element_type> mp;
+	std::vector<element_type *> chunks;
+	std::set<char *> live;
+	for (std::size_t i = 0; i < num; i++) {
+		element_type *chunk = mp.construct();
+		ASSERT_NE(chunk, nullptr);
+		EXPECT_TRUE(mp.owns(chunk));
+		EXPECT_TRUE(live.insert(reinterpret_cast<char *>(chunk)).second);
+		memset(chunk, static_cast<int>(i & 0xff), sizeof(element_type));
+		chunks.emplace_back(chunk);
+	}
+	// the chunks are packed, only the block headers are on top
+	const std::size_t chunk_num = memory_pool::SmallObjectPool<element_type>::chunk_num;
+	EXPECT_EQ(mp.get_block_num(), (num + chunk_num - 1) / chunk_num);
+	EXPECT_EQ(reinterpret_cast<char *>(chunks[1]) - reinterpret_cast<char *>(chunks[0]),
+	          sizeof(element_type));
+
+	for (std::size_t i = 0; i < num; i++) {
+		EXPECT_EQ(static_cast<unsigned char>(*reinterpret_cast<char *>(chunks[i])), i & 0xff);
+	}
+	// the freed chunks are reused before a new block
+	for (std::size_t i = 0; i < num; i += 2)
+		mp.destroy(chunks[i]);
+	for (std::size_t i = 0; i < num; i += 2)
+		chunks[i] = mp.construct();
+	EXPECT_EQ(mp.get_block_num(), (num + chunk_num - 1) / chunk_num);
+
+	EXPECT_FALSE(mp.release_memory());
+	for (auto chunk : chunks)
+		mp.destroy(chunk);
+	EXPECT_TRUE(mp.release_memory());
+	EXPECT_EQ(mp.get_block_num(), 0);
+	EXPECT_FALSE(mp.owns(chunks.front()));
+}
+
+TEST(SmallObjectPoolTest, TestChunkNum) {
+	// one bit of bitmap on top of a byte, nothing on top of bigger types
+	EXPECT_TRUE(memory_pool::SmallObjectPool<ByteType>::bitmap_mode);
+	EXPECT_GE(memory_pool::SmallObjectPool<ByteType>::chunk_num, 64 * 1024 * 8 / 9 - 128);
+	EXPECT_FALSE(memory_pool::SmallObjectPool<std::uint16_t>::bitmap_mode);
+	EXPECT_GE(memory_pool::SmallObjectPool<std::uint16_t>::chunk_num, 32 * 1024 - 64);
+	EXPECT_GE(memory_pool::SmallObjectPool<Rgb>::chunk_num, 64 * 1024 / 3 - 64);
+	EXPECT_GE((memory_pool::SmallObjectPool<std::uint32_t, 4096>::chunk_num), 1024 - 16);
+}
+
+TEST(SmallObjectPoolTest, TestByteType) {
+	check_pool<ByteType>(200000);
+}
+
+TEST(SmallObjectPoolTest, TestShort) {
+	check_pool<std::uint16_t>(100000);
+}
+
+TEST(SmallObjectPoolTest, TestUnalignedIndex) {
+	check_pool<Rgb>(50000);
+}
+
+TEST(SmallObjectPoolTest, TestInt) {
+	check_pool<int>(50000);
+}
+
+TEST(SmallObjectPoolTest, TestPurgeMemory) {
+	{
+		memory_pool::SmallObjectPool<Counter> mp;
+		std::vector<Counter *> chunks;
+		for (std::uint16_t i = 0; i < 1000; i++)
+			chunks.emplace_back(mp.construct(i));
+		EXPECT_EQ(chunks[999]->value, 999);
+		for (std::size_t i = 0; i < chunks.size(); i += 3)
+			mp.destroy(chunks[i]);
+		EXPECT_EQ(Counter::live, 666);
+	}
+	// the pool destroys the objects left
+	EXPECT_EQ(Counter::live, 0);
+}
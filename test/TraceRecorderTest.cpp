@@ -0,0 +1,139 @@
+/*
+ * @author: Pei Mu
+ * @description: GTest of the allocation trace recorder
+ * @data: 17th Oct 2026
+ * */
+
+#include <gtest/gtest.h>
+#include "MemoryPool.hpp"
+#include "TraceRecorder.hpp"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#define CHUNK_NUM 32
+
+struct Point {
+	int x, y, z;
+};
+
+typedef memory_pool::MemoryPool<Point, memory_pool::MallocBlockProvider,
+                                memory_pool::TraceRecorder> TraceMemoryPool;
+
+std::string trace_path(const char *name) {
+	return testing::TempDir() + name;
+}
+
+TEST(TraceRecorderTest, TestNotRecording) {
+	EXPECT_FALSE(memory_pool::TraceRecorder::recording());
+	TraceMemoryPool mp(CHUNK_NUM);
+	mp.destroy(mp.construct());
+	EXPECT_FALSE(memory_pool::TraceRecorder::start("/nonexistent/dir/trace"));
+	EXPECT_FALSE(memory_pool::TraceRecorder::recording());
+
+	std::vector<memory_pool::TraceRecord> records;
+	EXPECT_FALSE(memory_pool::read_trace("/nonexistent/dir/trace", records));
+}
+
+TEST(TraceRecorderTest, TestRecord) {
+	const std::string path = trace_path("trace_recorder_test.trace");
+	const std::size_t chunk_size = std::lcm(sizeof(Point), sizeof(void *));
+	ASSERT_TRUE(memory_pool::TraceRecorder::start(path.c_str()));
+	EXPECT_TRUE(memory_pool::TraceRecorder::recording());
+	{
+		TraceMemoryPool mp(CHUNK_NUM);
+		Point *first = mp.construct();
+		Point *second = mp.construct();
+		mp.destroy(first);
+		Point *batch[3];
+		mp.construct_n(batch, 3);
+		mp.destroy_n(batch, 3);
+		mp.ordered_destroy(second);
+	}
+	memory_pool::TraceRecorder::stop();
+	EXPECT_FALSE(memory_pool::TraceRecorder::recording());
+
+	std::vector<memory_pool::TraceRecord> records;
+	ASSERT_TRUE(memory_pool::read_trace(path.c_str(), records));
+	ASSERT_EQ(records.size(), 10);
+	const memory_pool::TraceOp ops[] = {
+	    memory_pool::TraceOp::construct, memory_pool::TraceOp::construct,
+	    memory_pool::TraceOp::destroy,   memory_pool::TraceOp::construct,
+	    memory_pool::TraceOp::construct, memory_pool::TraceOp::construct,
+	    memory_pool::TraceOp::destroy,   memory_pool::TraceOp::destroy,
+	    memory_pool::TraceOp::destroy,   memory_pool::TraceOp::destroy};
+	for (std::size_t i = 0; i < records.size(); i++) {
+		EXPECT_EQ(records[i].op, ops[i]);
+		EXPECT_EQ(records[i].size, chunk_size);
+	}
+	// the first chunk is reused by the batch, the last destroy is the second
+	EXPECT_EQ(records[2].object, records[0].object);
+	EXPECT_EQ(records[9].object, records[1].object);
+	EXPECT_NE(records[0].object, records[1].object);
+	remove(path.c_str());
+}
+
+TEST(TraceRecorderTest, TestFlush) {
+	const std::string path = trace_path("trace_recorder_flush.trace");
+	ASSERT_TRUE(memory_pool::TraceRecorder::start(path.c_str()));
+	TraceMemoryPool mp(CHUNK_NUM);
+	// a full buffer is written without flush()
+	for (std::size_t i = 1; i < memory_pool::TraceRecorder::buffer_records / 2;
+	     i++)
+		mp.destroy(mp.construct());
+	std::thread([&]() { mp.destroy(mp.construct()); }).join();
+	memory_pool::TraceRecorder::stop();
+
+	std::vector<memory_pool::TraceRecord> records;
+	ASSERT_TRUE(memory_pool::read_trace(path.c_str(), records));
+	ASSERT_EQ(records.size(), memory_pool::TraceRecorder::buffer_records);
+	EXPECT_NE(records.front().thread, records.back().thread);
+
+	// the records still buffered when the trace is stopped are dropped
+	ASSERT_TRUE(memory_pool::TraceRecorder::start(path.c_str()));
+	mp.destroy(mp.construct());
+	memory_pool::TraceRecorder::stop();
+	records.clear();
+	ASSERT_TRUE(memory_pool::read_trace(path.c_str(), records));
+	EXPECT_TRUE(records.empty());
+
+	ASSERT_TRUE(memory_pool::TraceRecorder::start(path.c_str()));
+	mp.destroy(mp.construct());
+	mp.get_stats().flush();
+	memory_pool::TraceRecorder::stop();
+	records.clear();
+	ASSERT_TRUE(memory_pool::read_trace(path.c_str(), records));
+	EXPECT_EQ(records.size(), 2);
+	remove(path.c_str());
+}
+
+TEST(TraceRecorderTest, TestInterleavedPools) {
+	const std::string path = trace_path("trace_recorder_interleaved.trace");
+	ASSERT_TRUE(memory_pool::TraceRecorder::start(path.c_str()));
+	TraceMemoryPool first_mp(CHUNK_NUM);
+	TraceMemoryPool second_mp(CHUNK_NUM);
+	Point *first = first_mp.construct();
+	Point *second = second_mp.construct();
+	first_mp.destroy(first);
+	second_mp.destroy(second);
+	// the buffer of the second pool is written first
+	second_mp.get_stats().flush();
+	first_mp.get_stats().flush();
+	memory_pool::TraceRecorder::stop();
+
+	std::vector<memory_pool::TraceRecord> records;
+	ASSERT_TRUE(memory_pool::read_trace(path.c_str(), records));
+	ASSERT_EQ(records.size(), 4);
+	const memory_pool::TraceOp ops[] = {
+	    memory_pool::TraceOp::construct, memory_pool::TraceOp::construct,
+	    memory_pool::TraceOp::destroy, memory_pool::TraceOp::destroy};
+	const Point *objects[] = {first, second, first, second};
+	for (std::size_t i = 0; i < records.size(); i++) {
+		EXPECT_EQ(records[i].op, ops[i]);
+		EXPECT_EQ(records[i].object, reinterpret_cast<std::uintptr_t>(objects[i]));
+		if (i > 0) {
+			EXPECT_LT(records[i - 1].sequence, records[i].sequence);
+		}
+	}
+	remove(path.c_str());
+}